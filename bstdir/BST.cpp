@@ -1,67 +1,7 @@
 #include <iostream>
-#include <vector>
-#include <algorithm>
+#include "BST.h"
 using namespace std;
 
-struct NodeBST {
-    int key;
-    NodeBST* left;
-    NodeBST* right;
-    NodeBST(int k) : key(k), left(nullptr), right(nullptr) {}
-};
-
-//создание узла
-NodeBST* CreateNodeBST(int key) {
-    return new NodeBST(key);
-}
-
-//добавление узла в BST
-NodeBST* InsertNode(NodeBST* root, int key) {
-    if (!root) return CreateNodeBST(key);
-
-    if (key < root->key)
-        root->left = InsertNode(root->left, key);
-    else if (key > root->key)
-        root->right = InsertNode(root->right, key);
-    
-    return root;
-}
-
-//обход inorder для получения отсортированных значений
-void InorderTraversal(NodeBST* root, vector<int>& values) {
-    if (!root) return;
-    InorderTraversal(root->left, values);
-    values.push_back(root->key);
-    InorderTraversal(root->right, values);
-}
-
-//восстановление правильных значений в дереве
-void RestoreValues(NodeBST* root, vector<int>& correctValues, int& index) {
-    if (!root) return;
-    RestoreValues(root->left, correctValues, index);
-    root->key = correctValues[index++];
-    RestoreValues(root->right, correctValues, index);
-}
-
-//основная функция восстановления BST
-NodeBST* RestoreBST(NodeBST* root) {
-    if (!root) return root;
-    
-    //1.получаем текущие значения в дереве
-    vector<int> currentValues;
-    InorderTraversal(root, currentValues);
-    
-    //2.сортируем значения (это будет правильный порядок для BST)
-    vector<int> correctValues = currentValues;
-    sort(correctValues.begin(), correctValues.end());
-    
-    //3.восстанавливаем значения в дереве, сохраняя структуру
-    int index = 0;
-    RestoreValues(root, correctValues, index);
-    
-    return root;
-}
-
 //обход слева-направо
 void InorderPrint(NodeBST* root) {
     if (!root) return;
@@ -0,0 +1,160 @@
+#ifndef BST_H
+#define BST_H
+
+#include <vector>
+#include <algorithm>
+
+struct NodeBST {
+    int key;
+    NodeBST* left;
+    NodeBST* right;
+    NodeBST(int k) : key(k), left(nullptr), right(nullptr) {}
+};
+
+//создание узла
+inline NodeBST* CreateNodeBST(int key) {
+    return new NodeBST(key);
+}
+
+//поиск узла по ключу
+inline NodeBST* FindNode(NodeBST* root, int key) {
+    while (root && root->key != key)
+        root = key < root->key ? root->left : root->right;
+    return root;
+}
+
+//добавление узла в BST
+inline NodeBST* InsertNode(NodeBST* root, int key) {
+    if (!root) return CreateNodeBST(key);
+
+    if (key < root->key)
+        root->left = InsertNode(root->left, key);
+    else if (key > root->key)
+        root->right = InsertNode(root->right, key);
+    
+    return root;
+}
+
+//удаление всего дерева без рекурсии: левые поддеревья поворотами переносятся
+//направо, и дерево разбирается как список
+inline void DeleteTree(NodeBST* root) {
+    while (root) {
+        if (root->left) {
+            NodeBST* left = root->left;
+            root->left = left->right;
+            left->right = root;
+            root = left;
+        } else {
+            NodeBST* next = root->right;
+            delete root;
+            root = next;
+        }
+    }
+}
+
+//обход inorder для получения отсортированных значений
+inline void InorderTraversal(NodeBST* root, std::vector<int>& values) {
+    if (!root) return;
+    InorderTraversal(root->left, values);
+    values.push_back(root->key);
+    InorderTraversal(root->right, values);
+}
+
+//восстановление правильных значений в дереве
+inline void RestoreValues(NodeBST* root, std::vector<int>& correctValues, int& index) {
+    if (!root) return;
+    RestoreValues(root->left, correctValues, index);
+    root->key = correctValues[index++];
+    RestoreValues(root->right, correctValues, index);
+}
+
+//обход inorder без рекурсии и стека (Morris): правый указатель самого правого узла
+//левого поддерева временно указывает на текущий узел и снимается при повторном заходе.
+//обход всегда доходит до конца, иначе в дереве останутся временные ссылки
+template<typename Visit>
+void MorrisInorder(NodeBST* root, Visit visit) {
+    NodeBST* current = root;
+    while (current) {
+        if (!current->left) {
+            visit(current);
+            current = current->right;
+            continue;
+        }
+
+        NodeBST* predecessor = current->left;
+        while (predecessor->right && predecessor->right != current)
+            predecessor = predecessor->right;
+
+        if (!predecessor->right) {
+            predecessor->right = current;
+            current = current->left;
+        } else {
+            predecessor->right = nullptr;
+            visit(current);
+            current = current->right;
+        }
+    }
+}
+
+//проверка порядка inorder без дополнительной памяти
+inline bool IsInorderSorted(NodeBST* root) {
+    NodeBST* previous = nullptr;
+    bool sorted = true;
+    MorrisInorder(root, [&](NodeBST* node) {
+        if (previous && previous->key > node->key) sorted = false;
+        previous = node;
+    });
+    return sorted;
+}
+
+//исправление двух поменянных местами узлов за один обход Morris, O(1) памяти.
+//меняются ключи только двух найденных узлов; если нарушений порядка больше двух
+//или обмен не упорядочил дерево, дерево остается как было и возвращается false
+inline bool RecoverSwappedNodes(NodeBST* root) {
+    NodeBST* previous = nullptr;
+    NodeBST* first = nullptr;  //старший узел первого нарушения
+    NodeBST* second = nullptr; //младший узел последнего нарушения
+    int violations = 0;
+    MorrisInorder(root, [&](NodeBST* node) {
+        if (previous && previous->key > node->key) {
+            violations++;
+            if (!first) first = previous;
+            second = node;
+        }
+        previous = node;
+    });
+
+    if (violations == 0) return true;
+    if (violations > 2) return false;
+
+    std::swap(first->key, second->key);
+    if (!IsInorderSorted(root)) {
+        std::swap(first->key, second->key);
+        return false;
+    }
+    return true;
+}
+
+//основная функция восстановления BST
+inline NodeBST* RestoreBST(NodeBST* root) {
+    if (!root) return root;
+    
+    //0.обычный случай - поменяны два узла: исправляем без копирования и сортировки
+    if (RecoverSwappedNodes(root)) return root;
+    
+    //1.получаем текущие значения в дереве
+    std::vector<int> currentValues;
+    InorderTraversal(root, currentValues);
+    
+    //2.сортируем значения (это будет правильный порядок для BST)
+    std::vector<int> correctValues = currentValues;
+    std::sort(correctValues.begin(), correctValues.end());
+    
+    //3.восстанавливаем значения в дереве, сохраняя структуру
+    int index = 0;
+    RestoreValues(root, correctValues, index);
+    
+    return root;
+}
+
+#endif
\ No newline at end of file
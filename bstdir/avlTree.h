@@ -0,0 +1,198 @@
+#ifndef AVL_TREE_H
+#define AVL_TREE_H
+
+#include <vector>
+#include <algorithm>
+
+struct NodeAVL {
+    int key;
+    int height;
+    NodeAVL* left;
+    NodeAVL* right;
+    NodeAVL(int k) : key(k), height(1), left(nullptr), right(nullptr) {}
+};
+
+//сбалансированное дерево поиска (AVL): высоты поддеревьев любого узла отличаются
+//не больше чем на 1, поэтому высота дерева не больше 1.44 log2(n) при любом порядке вставок.
+//вставка, удаление и поиск без рекурсии: путь от корня хранится в массиве адресов
+//указателей на узлы, и после изменения поддеревья перебалансируются снизу вверх
+class AVLTree {
+private:
+    //высота AVL-дерева из 2^31 узлов меньше 64
+    static const int MAX_HEIGHT = 64;
+
+    NodeAVL* root;
+    int count;
+
+    static int height(NodeAVL* node) {
+        return node ? node->height : 0;
+    }
+
+    static void updateHeight(NodeAVL* node) {
+        node->height = std::max(height(node->left), height(node->right)) + 1;
+    }
+
+    static NodeAVL* rotateRight(NodeAVL* node) {
+        NodeAVL* left = node->left;
+        node->left = left->right;
+        left->right = node;
+        updateHeight(node);
+        updateHeight(left);
+        return left;
+    }
+
+    static NodeAVL* rotateLeft(NodeAVL* node) {
+        NodeAVL* right = node->right;
+        node->right = right->left;
+        right->left = node;
+        updateHeight(node);
+        updateHeight(right);
+        return right;
+    }
+
+    //восстановление баланса узла, поддеревья которого уже сбалансированы;
+    //возвращает новый корень поддерева
+    static NodeAVL* rebalance(NodeAVL* node) {
+        updateHeight(node);
+        int balance = height(node->left) - height(node->right);
+        if (balance > 1) {
+            if (height(node->left->left) < height(node->left->right))
+                node->left = rotateLeft(node->left);
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (height(node->right->right) < height(node->right->left))
+                node->right = rotateRight(node->right);
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    //перебалансировка по пути снизу вверх; выше узла, который не повернулся
+    //и не изменил высоту, ничего не меняется
+    static void rebalancePath(NodeAVL** path[], int depth) {
+        for (int i = depth - 1; i >= 0; i--) {
+            NodeAVL* node = *path[i];
+            int oldHeight = node->height;
+            *path[i] = rebalance(node);
+            if (*path[i] == node && node->height == oldHeight) break;
+        }
+    }
+
+public:
+    AVLTree() : root(nullptr), count(0) {}
+
+    ~AVLTree() {
+        clear();
+    }
+
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+
+    NodeAVL* find(int key) const {
+        NodeAVL* node = root;
+        while (node && node->key != key)
+            node = key < node->key ? node->left : node->right;
+        return node;
+    }
+
+    bool contains(int key) const {
+        return find(key) != nullptr;
+    }
+
+    //вставка; false - ключ уже есть
+    bool insert(int key) {
+        NodeAVL** path[MAX_HEIGHT];
+        int depth = 0;
+        NodeAVL** link = &root;
+        while (*link) {
+            if (key == (*link)->key) return false;
+            path[depth++] = link;
+            link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+        }
+
+        *link = new NodeAVL(key);
+        count++;
+        rebalancePath(path, depth);
+        return true;
+    }
+
+    //удаление; false - ключа нет.
+    //у узла с двумя детьми ключ заменяется ключом следующего узла, а удаляется тот
+    bool erase(int key) {
+        NodeAVL** path[MAX_HEIGHT];
+        int depth = 0;
+        NodeAVL** link = &root;
+        while (*link && (*link)->key != key) {
+            path[depth++] = link;
+            link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+        }
+        if (!*link) return false;
+
+        NodeAVL* node = *link;
+        if (node->left && node->right) {
+            path[depth++] = link;
+            NodeAVL** successor = &node->right;
+            while ((*successor)->left) {
+                path[depth++] = successor;
+                successor = &(*successor)->left;
+            }
+            NodeAVL* removed = *successor;
+            node->key = removed->key;
+            *successor = removed->right;
+            delete removed;
+        } else {
+            *link = node->left ? node->left : node->right;
+            delete node;
+        }
+
+        count--;
+        rebalancePath(path, depth);
+        return true;
+    }
+
+    //удаление всех узлов без рекурсии (как DeleteTree для NodeBST)
+    void clear() {
+        NodeAVL* node = root;
+        while (node) {
+            if (node->left) {
+                NodeAVL* left = node->left;
+                node->left = left->right;
+                left->right = node;
+                node = left;
+            } else {
+                NodeAVL* next = node->right;
+                delete node;
+                node = next;
+            }
+        }
+        root = nullptr;
+        count = 0;
+    }
+
+    //ключи по возрастанию, без рекурсии
+    void inorder(std::vector<int>& values) const {
+        NodeAVL* stack[MAX_HEIGHT];
+        int top = 0;
+        NodeAVL* node = root;
+        while (node || top > 0) {
+            while (node) {
+                stack[top++] = node;
+                node = node->left;
+            }
+            node = stack[--top];
+            values.push_back(node->key);
+            node = node->right;
+        }
+    }
+
+    int size() const {
+        return count;
+    }
+
+    int treeHeight() const {
+        return height(root);
+    }
+};
+
+#endif
\ No newline at end of file
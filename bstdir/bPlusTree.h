@@ -0,0 +1,491 @@
+#ifndef B_PLUS_TREE_H
+#define B_PLUS_TREE_H
+
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <climits>
+#include <cstddef>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+//B+-дерево множества int: все ключи лежат в листьях, листья связаны в список по возрастанию,
+//внутренние узлы хранят только разделители. ключи узла занимают целые кэш-линии,
+//свободные места заполнены INT_MAX, поэтому поиск в узле - несколько сравнений SIMD
+//по всем местам сразу без ветвлений и без учета числа ключей
+class BPlusTree {
+private:
+    static const int LEAF_KEYS = 28;  //лист - ровно 2 кэш-линии
+    static const int MIN_LEAF_KEYS = LEAF_KEYS / 2;
+    static const int INNER_KEYS = 16; //разделители внутреннего узла - ровно одна кэш-линия
+    static const int MIN_INNER_KEYS = INNER_KEYS / 2;
+    static const int MAX_DEPTH = 32;
+
+    struct Node {};
+
+    struct alignas(64) Leaf : Node {
+        int keys[LEAF_KEYS];
+        int count;
+        Leaf* next;
+
+        Leaf() : count(0), next(nullptr) {
+            std::fill(keys, keys + LEAF_KEYS, INT_MAX);
+        }
+    };
+
+    //в children[i] ключи из [keys[i-1], keys[i])
+    struct alignas(64) Inner : Node {
+        int keys[INNER_KEYS];
+        int count;
+        Node* children[INNER_KEYS + 1];
+
+        Inner() : count(0) {
+            std::fill(keys, keys + INNER_KEYS, INT_MAX);
+            std::fill(children, children + INNER_KEYS + 1, nullptr);
+        }
+    };
+
+    Node* root;
+    int height; //1 - корень является листом
+    Leaf* firstLeaf;
+    size_t keyCount;
+    size_t leafCount;
+    size_t innerCount;
+
+    //число элементов keys[0..lanes), меньших key; lanes кратно 4
+    static int countLess(const int* keys, int lanes, int key) {
+#ifdef __SSE2__
+        __m128i needle = _mm_set1_epi32(key);
+        int total = 0;
+        for (int i = 0; i < lanes; i += 4) {
+            __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i));
+            total += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(needle, block))));
+        }
+        return total;
+#else
+        int total = 0;
+        for (int i = 0; i < lanes; i++) total += keys[i] < key;
+        return total;
+#endif
+    }
+
+    //номер ребенка для key: число разделителей не больше key
+    static int childSlot(const Inner* inner, int key) {
+        int slot = key == INT_MAX ? INNER_KEYS : countLess(inner->keys, INNER_KEYS, key + 1);
+        return std::min(slot, inner->count);
+    }
+
+    //спуск к листу с запоминанием пути
+    Leaf* descend(int key, Inner** path, int* slots) const {
+        Node* node = root;
+        for (int level = 0; level < height - 1; level++) {
+            Inner* inner = static_cast<Inner*>(node);
+            int slot = childSlot(inner, key);
+            if (path) {
+                path[level] = inner;
+                slots[level] = slot;
+            }
+            node = inner->children[slot];
+        }
+        return static_cast<Leaf*>(node);
+    }
+
+    //удаление разделителя keys[slot-1] и ребенка children[slot]
+    static void removeChild(Inner* inner, int slot) {
+        for (int i = slot - 1; i + 1 < inner->count; i++) inner->keys[i] = inner->keys[i + 1];
+        for (int i = slot; i < inner->count; i++) inner->children[i] = inner->children[i + 1];
+        inner->keys[inner->count - 1] = INT_MAX;
+        inner->children[inner->count] = nullptr;
+        inner->count--;
+    }
+
+    //лист с недостатком ключей берет ключ у соседа или сливается с ним
+    void fixLeaf(Leaf* leaf, Inner* parent, int slot) {
+        if (slot > 0) {
+            Leaf* left = static_cast<Leaf*>(parent->children[slot - 1]);
+            if (left->count > MIN_LEAF_KEYS) {
+                for (int i = leaf->count; i > 0; i--) leaf->keys[i] = leaf->keys[i - 1];
+                leaf->keys[0] = left->keys[--left->count];
+                left->keys[left->count] = INT_MAX;
+                leaf->count++;
+                parent->keys[slot - 1] = leaf->keys[0];
+                return;
+            }
+            std::copy(leaf->keys, leaf->keys + leaf->count, left->keys + left->count);
+            left->count += leaf->count;
+            left->next = leaf->next;
+            delete leaf;
+            leafCount--;
+            removeChild(parent, slot);
+        } else {
+            Leaf* right = static_cast<Leaf*>(parent->children[1]);
+            if (right->count > MIN_LEAF_KEYS) {
+                leaf->keys[leaf->count++] = right->keys[0];
+                for (int i = 0; i + 1 < right->count; i++) right->keys[i] = right->keys[i + 1];
+                right->keys[--right->count] = INT_MAX;
+                parent->keys[0] = right->keys[0];
+                return;
+            }
+            std::copy(right->keys, right->keys + right->count, leaf->keys + leaf->count);
+            leaf->count += right->count;
+            leaf->next = right->next;
+            delete right;
+            leafCount--;
+            removeChild(parent, 1);
+        }
+    }
+
+    //то же для внутреннего узла: ключи проходят через разделитель в родителе
+    void fixInner(Inner* node, Inner* parent, int slot) {
+        if (slot > 0) {
+            Inner* left = static_cast<Inner*>(parent->children[slot - 1]);
+            if (left->count > MIN_INNER_KEYS) {
+                for (int i = node->count; i > 0; i--) node->keys[i] = node->keys[i - 1];
+                for (int i = node->count + 1; i > 0; i--) node->children[i] = node->children[i - 1];
+                node->keys[0] = parent->keys[slot - 1];
+                node->children[0] = left->children[left->count];
+                node->count++;
+                parent->keys[slot - 1] = left->keys[left->count - 1];
+                left->keys[left->count - 1] = INT_MAX;
+                left->children[left->count] = nullptr;
+                left->count--;
+                return;
+            }
+            left->keys[left->count] = parent->keys[slot - 1];
+            std::copy(node->keys, node->keys + node->count, left->keys + left->count + 1);
+            std::copy(node->children, node->children + node->count + 1, left->children + left->count + 1);
+            left->count += node->count + 1;
+            delete node;
+            innerCount--;
+            removeChild(parent, slot);
+        } else {
+            Inner* right = static_cast<Inner*>(parent->children[1]);
+            if (right->count > MIN_INNER_KEYS) {
+                node->keys[node->count] = parent->keys[0];
+                node->children[node->count + 1] = right->children[0];
+                node->count++;
+                parent->keys[0] = right->keys[0];
+                for (int i = 0; i + 1 < right->count; i++) right->keys[i] = right->keys[i + 1];
+                for (int i = 0; i < right->count; i++) right->children[i] = right->children[i + 1];
+                right->keys[right->count - 1] = INT_MAX;
+                right->children[right->count] = nullptr;
+                right->count--;
+                return;
+            }
+            node->keys[node->count] = parent->keys[0];
+            std::copy(right->keys, right->keys + right->count, node->keys + node->count + 1);
+            std::copy(right->children, right->children + right->count + 1, node->children + node->count + 1);
+            node->count += right->count + 1;
+            delete right;
+            innerCount--;
+            removeChild(parent, 1);
+        }
+    }
+
+    void freeNode(Node* node, int level) {
+        if (level < height - 1) {
+            Inner* inner = static_cast<Inner*>(node);
+            for (int i = 0; i <= inner->count; i++) freeNode(inner->children[i], level + 1);
+            delete inner;
+        } else {
+            delete static_cast<Leaf*>(node);
+        }
+    }
+
+    //размеры групп по maxSize, последняя группа не меньше minSize (если групп больше одной)
+    static std::vector<size_t> groupSizes(size_t total, size_t maxSize, size_t minSize) {
+        std::vector<size_t> sizes((total + maxSize - 1) / maxSize, maxSize);
+        if (sizes.empty()) return sizes;
+        sizes.back() = total - maxSize * (sizes.size() - 1);
+        if (sizes.size() > 1 && sizes.back() < minSize) {
+            size_t pair = maxSize + sizes.back();
+            sizes[sizes.size() - 2] = pair - pair / 2;
+            sizes.back() = pair / 2;
+        }
+        return sizes;
+    }
+
+public:
+    //итератор по ключам в порядке возрастания; end - лист nullptr
+    class Iterator {
+    private:
+        const Leaf* leaf;
+        int index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        Iterator() : leaf(nullptr), index(0) {}
+
+        Iterator(const Leaf* l, int i) : leaf(l), index(i) {
+            if (leaf && index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+        }
+
+        reference operator*() const {
+            return leaf->keys[index];
+        }
+
+        pointer operator->() const {
+            return &leaf->keys[index];
+        }
+
+        Iterator& operator++() {
+            if (++index == leaf->count) {
+                leaf = leaf->next;
+                index = 0;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return leaf == other.leaf && index == other.index;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    BPlusTree() : root(nullptr), height(1), firstLeaf(nullptr), keyCount(0), leafCount(0), innerCount(0) {
+        clear();
+    }
+
+    ~BPlusTree() {
+        freeNode(root, 0);
+    }
+
+    BPlusTree(const BPlusTree&) = delete;
+    BPlusTree& operator=(const BPlusTree&) = delete;
+
+    void clear() {
+        if (root) freeNode(root, 0);
+        firstLeaf = new Leaf();
+        root = firstLeaf;
+        height = 1;
+        keyCount = 0;
+        leafCount = 1;
+        innerCount = 0;
+    }
+
+    bool find(int key) const {
+        const Leaf* leaf = descend(key, nullptr, nullptr);
+        int position = countLess(leaf->keys, LEAF_KEYS, key);
+        return position < leaf->count && leaf->keys[position] == key;
+    }
+
+    Iterator lowerBound(int key) const {
+        const Leaf* leaf = descend(key, nullptr, nullptr);
+        return Iterator(leaf, countLess(leaf->keys, LEAF_KEYS, key));
+    }
+
+    Iterator begin() const {
+        return Iterator(firstLeaf, 0);
+    }
+
+    Iterator end() const {
+        return Iterator(nullptr, 0);
+    }
+
+    //обход ключей из [from, to) по цепочке листьев
+    template<typename Visit>
+    void range(int from, int to, Visit visit) const {
+        for (Iterator it = lowerBound(from); it != end() && *it < to; ++it) visit(*it);
+    }
+
+    //вставка; false - ключ уже есть. переполненный узел делится пополам,
+    //разделитель поднимается в родителя, деление может дойти до нового корня
+    bool insert(int key) {
+        Inner* path[MAX_DEPTH];
+        int slots[MAX_DEPTH];
+        Leaf* leaf = descend(key, path, slots);
+        int position = countLess(leaf->keys, LEAF_KEYS, key);
+        if (position < leaf->count && leaf->keys[position] == key) return false;
+        keyCount++;
+
+        if (leaf->count < LEAF_KEYS) {
+            for (int i = leaf->count; i > position; i--) leaf->keys[i] = leaf->keys[i - 1];
+            leaf->keys[position] = key;
+            leaf->count++;
+            return true;
+        }
+
+        int merged[LEAF_KEYS + 1];
+        std::copy(leaf->keys, leaf->keys + position, merged);
+        merged[position] = key;
+        std::copy(leaf->keys + position, leaf->keys + LEAF_KEYS, merged + position + 1);
+
+        Leaf* right = new Leaf();
+        leafCount++;
+        int leftCount = (LEAF_KEYS + 2) / 2;
+        std::fill(leaf->keys, leaf->keys + LEAF_KEYS, INT_MAX);
+        std::copy(merged, merged + leftCount, leaf->keys);
+        std::copy(merged + leftCount, merged + LEAF_KEYS + 1, right->keys);
+        leaf->count = leftCount;
+        right->count = LEAF_KEYS + 1 - leftCount;
+        right->next = leaf->next;
+        leaf->next = right;
+
+        int separator = right->keys[0];
+        Node* newChild = right;
+        for (int level = height - 2; level >= 0; level--) {
+            Inner* inner = path[level];
+            int slot = slots[level];
+            if (inner->count < INNER_KEYS) {
+                for (int i = inner->count; i > slot; i--) inner->keys[i] = inner->keys[i - 1];
+                for (int i = inner->count + 1; i > slot + 1; i--) inner->children[i] = inner->children[i - 1];
+                inner->keys[slot] = separator;
+                inner->children[slot + 1] = newChild;
+                inner->count++;
+                return true;
+            }
+
+            int keys[INNER_KEYS + 1];
+            Node* children[INNER_KEYS + 2];
+            std::copy(inner->keys, inner->keys + slot, keys);
+            keys[slot] = separator;
+            std::copy(inner->keys + slot, inner->keys + INNER_KEYS, keys + slot + 1);
+            std::copy(inner->children, inner->children + slot + 1, children);
+            children[slot + 1] = newChild;
+            std::copy(inner->children + slot + 1, inner->children + INNER_KEYS + 1, children + slot + 2);
+
+            //левая половина - MIN_INNER_KEYS ключей, средний ключ уходит вверх, правая - остальные
+            Inner* rightInner = new Inner();
+            innerCount++;
+            std::fill(inner->keys, inner->keys + INNER_KEYS, INT_MAX);
+            std::fill(inner->children, inner->children + INNER_KEYS + 1, nullptr);
+            std::copy(keys, keys + MIN_INNER_KEYS, inner->keys);
+            std::copy(children, children + MIN_INNER_KEYS + 1, inner->children);
+            inner->count = MIN_INNER_KEYS;
+            std::copy(keys + MIN_INNER_KEYS + 1, keys + INNER_KEYS + 1, rightInner->keys);
+            std::copy(children + MIN_INNER_KEYS + 1, children + INNER_KEYS + 2, rightInner->children);
+            rightInner->count = INNER_KEYS - MIN_INNER_KEYS;
+
+            separator = keys[MIN_INNER_KEYS];
+            newChild = rightInner;
+        }
+
+        Inner* newRoot = new Inner();
+        innerCount++;
+        newRoot->keys[0] = separator;
+        newRoot->children[0] = root;
+        newRoot->children[1] = newChild;
+        newRoot->count = 1;
+        root = newRoot;
+        height++;
+        return true;
+    }
+
+    //удаление; false - ключа нет. узел меньше половины берет ключ у соседа
+    //или сливается с ним, корень без разделителей заменяется единственным ребенком
+    bool erase(int key) {
+        Inner* path[MAX_DEPTH];
+        int slots[MAX_DEPTH];
+        Leaf* leaf = descend(key, path, slots);
+        int position = countLess(leaf->keys, LEAF_KEYS, key);
+        if (position == leaf->count || leaf->keys[position] != key) return false;
+
+        for (int i = position; i + 1 < leaf->count; i++) leaf->keys[i] = leaf->keys[i + 1];
+        leaf->keys[--leaf->count] = INT_MAX;
+        keyCount--;
+        if (height == 1 || leaf->count >= MIN_LEAF_KEYS) return true;
+
+        fixLeaf(leaf, path[height - 2], slots[height - 2]);
+        for (int level = height - 2; level > 0 && path[level]->count < MIN_INNER_KEYS; level--) {
+            fixInner(path[level], path[level - 1], slots[level - 1]);
+        }
+        Inner* top = static_cast<Inner*>(root);
+        if (top->count == 0) {
+            root = top->children[0];
+            delete top;
+            innerCount--;
+            height--;
+        }
+        return true;
+    }
+
+    //построение из отсортированных ключей за O(n): листья заполняются целиком
+    //(кроме, возможно, двух последних), уровни разделителей строятся снизу вверх.
+    //повторяющиеся ключи пропускаются
+    void bulkLoad(const std::vector<int>& sortedKeys) {
+        if (!std::is_sorted(sortedKeys.begin(), sortedKeys.end()))
+            throw std::runtime_error("Ключи для загрузки B+-дерева должны быть отсортированы");
+        std::vector<int> keys;
+        keys.reserve(sortedKeys.size());
+        std::unique_copy(sortedKeys.begin(), sortedKeys.end(), std::back_inserter(keys));
+
+        clear();
+        if (keys.empty()) return;
+        delete firstLeaf;
+        leafCount = 0;
+
+        std::vector<Node*> level;
+        std::vector<int> minimums; //наименьший ключ каждого поддерева уровня
+        Leaf* previous = nullptr;
+        size_t next = 0;
+        for (size_t size : groupSizes(keys.size(), LEAF_KEYS, MIN_LEAF_KEYS)) {
+            Leaf* leaf = new Leaf();
+            leafCount++;
+            std::copy(keys.begin() + next, keys.begin() + next + size, leaf->keys);
+            leaf->count = size;
+            if (previous) previous->next = leaf; else firstLeaf = leaf;
+            previous = leaf;
+            level.push_back(leaf);
+            minimums.push_back(keys[next]);
+            next += size;
+        }
+
+        height = 1;
+        while (level.size() > 1) {
+            std::vector<Node*> parents;
+            std::vector<int> parentMinimums;
+            size_t first = 0;
+            for (size_t size : groupSizes(level.size(), INNER_KEYS + 1, MIN_INNER_KEYS + 1)) {
+                Inner* inner = new Inner();
+                innerCount++;
+                for (size_t i = 0; i < size; i++) {
+                    inner->children[i] = level[first + i];
+                    if (i > 0) inner->keys[i - 1] = minimums[first + i];
+                }
+                inner->count = size - 1;
+                parents.push_back(inner);
+                parentMinimums.push_back(minimums[first]);
+                first += size;
+            }
+            level.swap(parents);
+            minimums.swap(parentMinimums);
+            height++;
+        }
+        root = level[0];
+        keyCount = keys.size();
+    }
+
+    size_t size() const {
+        return keyCount;
+    }
+
+    int treeHeight() const {
+        return height;
+    }
+
+    //память узлов в байтах
+    size_t memoryBytes() const {
+        return leafCount * sizeof(Leaf) + innerCount * sizeof(Inner);
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,415 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <malloc.h>
+#include "BST.h"
+#include "avlTree.h"
+#include "eytzinger.h"
+#include "bPlusTree.h"
+#include "nodeArena.h"
+#include "parallelRestore.h"
+
+using namespace std;
+using namespace std::chrono;
+
+//дополнение пробелами по числу символов, а не байтов (для кириллицы)
+string padRight(const string& text, int width) {
+    int letters = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) letters++;
+    }
+    return text + string(max(0, width - letters), ' ');
+}
+
+double secondsSince(steady_clock::time_point start) {
+    return duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1e9;
+}
+
+//высота дерева без рекурсии: у вырожденного дерева она равна числу узлов
+int TreeHeight(NodeBST* root) {
+    int height = 0;
+    vector<pair<NodeBST*, int>> stack;
+    if (root) stack.push_back({root, 1});
+    while (!stack.empty()) {
+        NodeBST* node = stack.back().first;
+        int depth = stack.back().second;
+        stack.pop_back();
+        height = max(height, depth);
+        if (node->left) stack.push_back({node->left, depth + 1});
+        if (node->right) stack.push_back({node->right, depth + 1});
+    }
+    return height;
+}
+
+struct TreeResult {
+    double insertTime;
+    double findTime;
+    int height;
+    long long found;
+};
+
+TreeResult measureInsertNode(const vector<int>& keys, const vector<int>& queries) {
+    TreeResult result;
+    auto start = steady_clock::now();
+    NodeBST* root = nullptr;
+    for (int key : keys) root = InsertNode(root, key);
+    result.insertTime = secondsSince(start);
+
+    start = steady_clock::now();
+    result.found = 0;
+    for (int key : queries) result.found += FindNode(root, key) != nullptr;
+    result.findTime = secondsSince(start);
+
+    result.height = TreeHeight(root);
+    DeleteTree(root);
+    return result;
+}
+
+TreeResult measureAvl(const vector<int>& keys, const vector<int>& queries) {
+    TreeResult result;
+    auto start = steady_clock::now();
+    AVLTree tree;
+    for (int key : keys) tree.insert(key);
+    result.insertTime = secondsSince(start);
+
+    start = steady_clock::now();
+    result.found = 0;
+    for (int key : queries) result.found += tree.contains(key);
+    result.findTime = secondsSince(start);
+
+    result.height = tree.treeHeight();
+    return result;
+}
+
+void printRow(const string& order, int size, const string& name, const TreeResult& r, int queries) {
+    cout << "│ " << padRight(order, 10) << " │ " << setw(8) << size << " │ " << padRight(name, 10) << " │ "
+         << fixed << setprecision(4) << setw(10) << r.insertTime << " │ "
+         << setprecision(2) << setw(12) << queries / r.findTime / 1e6 << " │ "
+         << setw(8) << r.height << " │\n";
+}
+
+//вставка и поиск в InsertNode (без балансировки) и AVLTree на упорядоченных,
+//обратно упорядоченных и случайных ключах
+void benchmarkBalanced() {
+    const int sizes[] = {20000, 1000000};
+    //InsertNode на упорядоченных ключах строит список: время O(n^2), а глубина рекурсии
+    //равна n и при миллионе ключей переполняет стек
+    const int unbalancedLimit = 20000;
+    mt19937 gen(42);
+
+    cout << "\nInsertNode ПРОТИВ AVLTree (поиск - каждый ключ по разу в случайном порядке)\n";
+    cout << "┌────────────┬──────────┬────────────┬────────────┬──────────────┬──────────┐\n";
+    cout << "│ ключи      │ n        │ дерево     │ вставка, с │ поиск, Mops/s│ высота   │\n";
+    cout << "├────────────┼──────────┼────────────┼────────────┼──────────────┼──────────┤\n";
+
+    for (int size : sizes) {
+        vector<int> sorted(size);
+        for (int i = 0; i < size; i++) sorted[i] = 2 * i;
+        vector<int> queries = sorted;
+        shuffle(queries.begin(), queries.end(), gen);
+
+        vector<int> reversed(sorted.rbegin(), sorted.rend());
+        vector<int> random = queries;
+        shuffle(random.begin(), random.end(), gen);
+
+        const pair<string, const vector<int>*> orders[] = {
+            {"по возр.", &sorted}, {"по убыв.", &reversed}, {"случайные", &random}};
+        for (const auto& order : orders) {
+            const vector<int>& keys = *order.second;
+            bool degenerate = order.second != &random;
+            if (!degenerate || size <= unbalancedLimit) {
+                printRow(order.first, size, "InsertNode", measureInsertNode(keys, queries), size);
+            } else {
+                cout << "│ " << padRight(order.first, 10) << " │ " << setw(8) << size << " │ "
+                     << padRight("InsertNode", 10) << " │ " << padRight("переполн.", 10) << " │ "
+                     << setw(12) << "-" << " │ " << setw(8) << size << " │\n";
+            }
+            printRow("", size, "AVLTree", measureAvl(keys, queries), size);
+        }
+    }
+
+    cout << "└────────────┴──────────┴────────────┴────────────┴──────────────┴──────────┘\n";
+}
+
+//поиск по NodeBST (случайный порядок вставки) против отсортированного массива
+//и неизменяемых раскладок Эйтцингера и ван Эмде Боаса; около половины запросов - промахи
+void benchmarkStaticSearch() {
+    const int sizes[] = {10000, 1000000, 4000000};
+    const int queryCount = 4000000;
+    mt19937 gen(7);
+
+    cout << "\nПоиск: NodeBST ПРОТИВ статических раскладок, Mops/s\n";
+    cout << "┌──────────┬────────────┬────────────┬────────────┬────────────┬────────────┬───────────┐\n";
+    cout << "│ n        │ NodeBST    │ lower_bound│ Эйтцингер  │ пакет      │ vEB        │ ускорение │\n";
+    cout << "├──────────┼────────────┼────────────┼────────────┼────────────┼────────────┼───────────┤\n";
+
+    for (int size : sizes) {
+        vector<int> keys(size);
+        for (int i = 0; i < size; i++) keys[i] = 2 * i;
+        vector<int> order = keys;
+        shuffle(order.begin(), order.end(), gen);
+        NodeBST* root = nullptr;
+        for (int key : order) root = InsertNode(root, key);
+
+        uniform_int_distribution<int> dist(0, 2 * size - 1);
+        vector<int> queries(queryCount);
+        for (int& query : queries) query = dist(gen);
+
+        EytzingerSearch eytzinger(root);
+        VebSearch veb(root);
+        vector<uint8_t> batchFound(queryCount);
+
+        long long found[5] = {0, 0, 0, 0, 0};
+        double times[5];
+        auto start = steady_clock::now();
+        for (int query : queries) found[0] += FindNode(root, query) != nullptr;
+        times[0] = secondsSince(start);
+
+        start = steady_clock::now();
+        for (int query : queries) found[1] += binary_search(keys.begin(), keys.end(), query);
+        times[1] = secondsSince(start);
+
+        start = steady_clock::now();
+        for (int query : queries) found[2] += eytzinger.contains(query);
+        times[2] = secondsSince(start);
+
+        start = steady_clock::now();
+        eytzinger.containsBatch(queries.data(), queryCount, batchFound.data());
+        for (uint8_t hit : batchFound) found[3] += hit;
+        times[3] = secondsSince(start);
+
+        start = steady_clock::now();
+        for (int query : queries) found[4] += veb.contains(query);
+        times[4] = secondsSince(start);
+
+        cout << "│ " << setw(8) << size << " │ ";
+        for (int i = 0; i < 5; i++) {
+            cout << fixed << setprecision(2) << setw(10) << queryCount / times[i] / 1e6 << " │ ";
+        }
+        cout << setw(8) << times[0] / *min_element(times + 2, times + 5) << "x │";
+        for (int i = 1; i < 5; i++) {
+            if (found[i] != found[0]) cout << " расхождение!";
+        }
+        cout << "\n";
+        DeleteTree(root);
+    }
+
+    cout << "└──────────┴────────────┴────────────┴────────────┴────────────┴────────────┴───────────┘\n";
+}
+
+//занятая в куче память вместе со служебными заголовками распределителя (glibc)
+size_t heapInUse() {
+    return mallinfo2().uordblks;
+}
+
+struct IndexResult {
+    double buildTime;
+    size_t bytes;
+    double findTime;
+    double scanTime;
+    long long checksum;
+};
+
+void printIndexRow(int size, const string& name, const IndexResult& r, int queries) {
+    cout << "│ " << setw(8) << size << " │ " << padRight(name, 16) << " │ "
+         << fixed << setprecision(4) << setw(10) << r.buildTime << " │ "
+         << setprecision(1) << setw(8) << static_cast<double>(r.bytes) / size << " │ "
+         << setprecision(2) << setw(12) << queries / r.findTime / 1e6 << " │ "
+         << setw(12) << size / r.scanTime / 1e6 << " │\n";
+}
+
+//NodeBST ПРОТИВ B+-дерева с теми же ключами: построение, память, поиск и обход всех ключей
+void benchmarkBPlusTree() {
+    const int sizes[] = {100000, 1000000};
+    const int queryCount = 4000000;
+    mt19937 gen(11);
+
+    cout << "\nNodeBST ПРОТИВ BPlusTree (память - с заголовками распределителя)\n";
+    cout << "┌──────────┬──────────────────┬────────────┬──────────┬──────────────┬──────────────┐\n";
+    cout << "│ n        │ структура        │ сборка, с  │ байт/ключ│ поиск, Mops/s│ обход, Mkey/s│\n";
+    cout << "├──────────┼──────────────────┼────────────┼──────────┼──────────────┼──────────────┤\n";
+
+    for (int size : sizes) {
+        vector<int> keys(size);
+        for (int i = 0; i < size; i++) keys[i] = 2 * i;
+        vector<int> order = keys;
+        shuffle(order.begin(), order.end(), gen);
+        uniform_int_distribution<int> dist(0, 2 * size - 1);
+        vector<int> queries(queryCount);
+        for (int& query : queries) query = dist(gen);
+
+        {
+            IndexResult r;
+            size_t before = heapInUse();
+            auto start = steady_clock::now();
+            NodeBST* root = nullptr;
+            for (int key : order) root = InsertNode(root, key);
+            r.buildTime = secondsSince(start);
+            r.bytes = heapInUse() - before;
+
+            start = steady_clock::now();
+            r.checksum = 0;
+            for (int query : queries) r.checksum += FindNode(root, query) != nullptr;
+            r.findTime = secondsSince(start);
+
+            start = steady_clock::now();
+            MorrisInorder(root, [&](NodeBST* node) { r.checksum += node->key; });
+            r.scanTime = secondsSince(start);
+            DeleteTree(root);
+            printIndexRow(size, "NodeBST", r, queryCount);
+        }
+
+        for (int bulk = 0; bulk < 2; bulk++) {
+            IndexResult r;
+            size_t before = heapInUse();
+            auto start = steady_clock::now();
+            BPlusTree tree;
+            if (bulk) {
+                tree.bulkLoad(keys);
+            } else {
+                for (int key : order) tree.insert(key);
+            }
+            r.buildTime = secondsSince(start);
+            r.bytes = heapInUse() - before;
+
+            start = steady_clock::now();
+            r.checksum = 0;
+            for (int query : queries) r.checksum += tree.find(query);
+            r.findTime = secondsSince(start);
+
+            start = steady_clock::now();
+            for (BPlusTree::Iterator it = tree.begin(); it != tree.end(); ++it) r.checksum += *it;
+            r.scanTime = secondsSince(start);
+            printIndexRow(size, bulk ? "BPlusTree, пакет" : "BPlusTree", r, queryCount);
+        }
+    }
+
+    cout << "└──────────┴──────────────────┴────────────┴──────────┴──────────────┴──────────────┘\n";
+}
+
+//перестройка дерева: InsertNode по ключам в случайном порядке и DeleteTree
+//против BuildBalancedBST в арене и одного release().
+//арена идет первой: после DeleteTree миллиона мелких блоков malloc сначала
+//собирает их, и это попало бы во время следующего выделения
+void benchmarkArenaBuild() {
+    const int sizes[] = {1000000, 4000000};
+    const int queryCount = 4000000;
+    mt19937 gen(13);
+
+    cout << "\nПерестройка NodeBST: InsertNode ПРОТИВ арены и BuildBalancedBST\n";
+    cout << "┌──────────┬────────────────────┬────────────┬────────────┬──────────────┬──────────┐\n";
+    cout << "│ n        │ способ             │ сборка, с  │ очистка, с │ поиск, Mops/s│ высота   │\n";
+    cout << "├──────────┼────────────────────┼────────────┼────────────┼──────────────┼──────────┤\n";
+
+    for (int size : sizes) {
+        vector<int> keys(size);
+        for (int i = 0; i < size; i++) keys[i] = 2 * i;
+        vector<int> order = keys;
+        shuffle(order.begin(), order.end(), gen);
+        uniform_int_distribution<int> dist(0, 2 * size - 1);
+        vector<int> queries(queryCount);
+        for (int& query : queries) query = dist(gen);
+
+        NodeArena arena;
+        long long expected = -1;
+        for (int arenaBuild = 1; arenaBuild >= 0; arenaBuild--) {
+            auto start = steady_clock::now();
+            NodeBST* root = nullptr;
+            if (arenaBuild) {
+                root = BuildBalancedBST(keys, arena);
+            } else {
+                for (int key : order) root = InsertNode(root, key);
+            }
+            double buildTime = secondsSince(start);
+
+            start = steady_clock::now();
+            long long found = 0;
+            for (int query : queries) found += FindNode(root, query) != nullptr;
+            double findTime = secondsSince(start);
+            int height = TreeHeight(root);
+
+            start = steady_clock::now();
+            if (arenaBuild) {
+                arena.release();
+            } else {
+                DeleteTree(root);
+            }
+            double freeTime = secondsSince(start);
+
+            cout << "│ " << setw(8) << size << " │ " << padRight(arenaBuild ? "арена, сбаланс." : "InsertNode", 18) << " │ "
+                 << fixed << setprecision(4) << setw(10) << buildTime << " │ "
+                 << setw(10) << freeTime << " │ "
+                 << setprecision(2) << setw(12) << queryCount / findTime / 1e6 << " │ "
+                 << setw(8) << height << " │" << (expected >= 0 && found != expected ? " расхождение!" : "") << "\n";
+            expected = found;
+        }
+    }
+
+    cout << "└──────────┴────────────────────┴────────────┴────────────┴──────────────┴──────────┘\n";
+}
+
+//сбалансированное дерево из отсортированных ключей, в котором ключи затем
+//переписываются по порядку inorder значениями scrambled
+NodeBST* BuildScrambledBST(const vector<int>& keys, const vector<int>& scrambled, NodeArena& arena) {
+    NodeBST* root = BuildBalancedBST(keys, arena);
+    size_t next = 0;
+    MorrisInorder(root, [&](NodeBST* node) { node->key = scrambled[next++]; });
+    return root;
+}
+
+//RestoreBST против ParallelRestoreBST на сбалансированном дереве, где перемешаны все ключи
+void benchmarkParallelRestore() {
+    const int size = 4000000;
+    const unsigned threadCounts[] = {2, 4, 8};
+    mt19937 gen(17);
+
+    vector<int> keys(size);
+    for (int i = 0; i < size; i++) keys[i] = 2 * i;
+    vector<int> scrambled = keys;
+    shuffle(scrambled.begin(), scrambled.end(), gen);
+
+    cout << "\nВосстановление BST с перемешанными ключами, n = " << size
+         << ", ядер: " << thread::hardware_concurrency() << "\n";
+    cout << "┌──────────────────────┬────────────┬───────────┐\n";
+    cout << "│ способ               │ время, с   │ ускорение │\n";
+    cout << "├──────────────────────┼────────────┼───────────┤\n";
+
+    NodeArena arena;
+    NodeBST* root = BuildScrambledBST(keys, scrambled, arena);
+    auto start = steady_clock::now();
+    RestoreBST(root);
+    double serialTime = secondsSince(start);
+    vector<int> expected = FrozenKeys(root);
+    arena.release();
+    cout << "│ " << padRight("RestoreBST", 20) << " │ " << fixed << setprecision(4) << setw(10) << serialTime
+         << " │ " << setprecision(2) << setw(8) << 1.0 << "x │\n";
+
+    for (unsigned threads : threadCounts) {
+        root = BuildScrambledBST(keys, scrambled, arena);
+        start = steady_clock::now();
+        ParallelRestoreBST(root, threads);
+        double time = secondsSince(start);
+        bool same = FrozenKeys(root) == expected;
+        arena.release();
+
+        cout << "│ " << padRight("Parallel, потоков " + to_string(threads), 20) << " │ "
+             << setprecision(4) << setw(10) << time << " │ "
+             << setprecision(2) << setw(8) << serialTime / time << "x │" << (same ? "" : " расхождение!") << "\n";
+    }
+
+    cout << "└──────────────────────┴────────────┴───────────┘\n";
+}
+
+int main() {
+    benchmarkBalanced();
+    benchmarkStaticSearch();
+    benchmarkBPlusTree();
+    benchmarkArenaBuild();
+    benchmarkParallelRestore();
+    return 0;
+}
\ No newline at end of file
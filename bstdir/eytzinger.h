@@ -0,0 +1,225 @@
+#ifndef EYTZINGER_H
+#define EYTZINGER_H
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <climits>
+#include <cstdint>
+#include <cstddef>
+#include "BST.h"
+
+//ключи дерева по возрастанию обходом Morris: без рекурсии, глубина дерева не важна
+inline std::vector<int> FrozenKeys(NodeBST* root) {
+    std::vector<int> keys;
+    MorrisInorder(root, [&](NodeBST* node) { keys.push_back(node->key); });
+    return keys;
+}
+
+inline void RequireSorted(const std::vector<int>& keys) {
+    if (!std::is_sorted(keys.begin(), keys.end()))
+        throw std::runtime_error("Ключи для статического поиска должны быть отсортированы");
+}
+
+//неизменяемое дерево поиска в порядке Эйтцингера (обход в ширину): корень в ячейке 1,
+//дети ячейки k - в 2k и 2k+1. указателей нет, первые уровни всех поисков делят
+//одни и те же кэш-линии, а 16 потомков узла на 4 уровня ниже лежат в одной линии -
+//их можно запросить заранее, пока идут сравнения на промежуточных уровнях
+class EytzingerSearch {
+private:
+    static const int KEYS_PER_LINE = 64 / sizeof(int);
+    static const int BATCH = 16;
+
+    std::vector<int> storage;
+    int* tree;    //ячейка 0 не используется, начало массива выровнено по кэш-линии
+    size_t count;
+    int levels;   //число уровней: 2^(levels-1) <= count < 2^levels
+
+    //inorder-обход полного дерева позиций раскладывает отсортированные ключи
+    void place(const std::vector<int>& keys, size_t& next, size_t k) {
+        if (k > count) return;
+        place(keys, next, 2 * k);
+        tree[k] = keys[next++];
+        place(keys, next, 2 * k + 1);
+    }
+
+    void build(const std::vector<int>& keys) {
+        RequireSorted(keys);
+        count = keys.size();
+        storage.assign(count + 1 + KEYS_PER_LINE, 0);
+        uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+        tree = storage.data() + (64 - address % 64) % 64 / sizeof(int);
+        levels = 0;
+        while ((size_t(1) << levels) <= count) levels++;
+        size_t next = 0;
+        place(keys, next, 1);
+    }
+
+    //один шаг спуска без ветвлений: позиции за пределами дерева считаются меньше ключа,
+    //поэтому все поиски делают ровно levels шагов
+    size_t step(size_t k, int key) const {
+        size_t index = k <= count ? k : 0;
+        return 2 * k + ((k > count) | (tree[index] < key));
+    }
+
+    //после спуска в битах k записан путь; последний поворот налево - ответ,
+    //отбрасываем завершающие единицы и этот ноль. 0 - все ключи меньше искомого
+    static size_t finish(size_t k) {
+        return k >> __builtin_ffsll(~k);
+    }
+
+public:
+    EytzingerSearch(const std::vector<int>& sortedKeys) {
+        build(sortedKeys);
+    }
+
+    EytzingerSearch(NodeBST* root) {
+        build(FrozenKeys(root));
+    }
+
+    EytzingerSearch(const EytzingerSearch&) = delete;
+    EytzingerSearch& operator=(const EytzingerSearch&) = delete;
+
+    //первый ключ не меньше key или nullptr.
+    //предвыборка уходит за конец массива на последних уровнях - на x86 это безопасно
+    const int* lowerBound(int key) const {
+        size_t k = 1;
+        for (int level = 0; level < levels; level++) {
+            __builtin_prefetch(tree + k * KEYS_PER_LINE);
+            k = step(k, key);
+        }
+        k = finish(k);
+        return k ? tree + k : nullptr;
+    }
+
+    bool contains(int key) const {
+        const int* found = lowerBound(key);
+        return found && *found == key;
+    }
+
+    //пакетный поиск: BATCH запросов спускаются по уровням одновременно,
+    //и промахи кэша разных запросов перекрываются
+    //found[i] = 1, если keys[i] есть в дереве, иначе 0
+    void containsBatch(const int* keys, size_t keyCount, uint8_t* found) const {
+        size_t k[BATCH];
+        for (size_t start = 0; start < keyCount; start += BATCH) {
+            size_t size = std::min<size_t>(BATCH, keyCount - start);
+            const int* batch = keys + start;
+            for (size_t j = 0; j < size; j++) k[j] = 1;
+            for (int level = 0; level < levels; level++) {
+                for (size_t j = 0; j < size; j++) {
+                    __builtin_prefetch(tree + k[j] * KEYS_PER_LINE);
+                    k[j] = step(k[j], batch[j]);
+                }
+            }
+            for (size_t j = 0; j < size; j++) {
+                size_t position = finish(k[j]);
+                found[start + j] = position != 0 && tree[position] == batch[j];
+            }
+        }
+    }
+
+    size_t size() const {
+        return count;
+    }
+};
+
+//неизменяемое дерево поиска в раскладке ван Эмде Боаса: полное дерево высоты h делится
+//на верхнее поддерево высоты h/2 и нижние под ним, каждое хранится подряд и раскладывается
+//так же рекурсивно. любой путь от корня проходит O(log n / log B) блоков для любого
+//размера блока B - выгодно для больших деревьев, где промахи идут и в TLB, и в память.
+//ключи дополняются до 2^h - 1 значением INT_MAX (до двух раз больше памяти)
+class VebSearch {
+private:
+    std::vector<int> layout;
+    int height;
+    int maxKey;
+    //для каждой глубины d (корень - глубина 1), на которой начинаются нижние поддеревья:
+    //размер верхнего поддерева, размер нижнего и глубина корня верхнего
+    std::vector<size_t> topSize;
+    std::vector<size_t> bottomSize;
+    std::vector<int> topDepth;
+
+    void split(int rootDepth, int subtreeHeight) {
+        if (subtreeHeight <= 1) return;
+        int top = subtreeHeight / 2;
+        int bottom = subtreeHeight - top;
+        int bottomDepth = rootDepth + top;
+        topSize[bottomDepth] = (size_t(1) << top) - 1;
+        bottomSize[bottomDepth] = (size_t(1) << bottom) - 1;
+        topDepth[bottomDepth] = rootDepth;
+        split(rootDepth, top);
+        split(bottomDepth, bottom);
+    }
+
+    //узел полного дерева с номером в ширину bfs стоит в отсортированном порядке
+    //на месте, которое определяется путем до него
+    static size_t inorderRank(size_t bfs, int depth, int treeHeight) {
+        int below = treeHeight - depth;
+        size_t levelStart = size_t(1) << (depth - 1);
+        //поддерево узла занимает 2^(below+1) - 1 мест, корень - в середине
+        return ((bfs - levelStart) << (below + 1)) + (size_t(1) << below) - 1;
+    }
+
+    void place(const std::vector<int>& keys, size_t bfs, int depth, int subtreeHeight, size_t& next) {
+        if (subtreeHeight == 1) {
+            size_t rank = inorderRank(bfs, depth, height);
+            layout[next++] = rank < keys.size() ? keys[rank] : INT_MAX;
+            return;
+        }
+        int top = subtreeHeight / 2;
+        int bottom = subtreeHeight - top;
+        place(keys, bfs, depth, top, next);
+        for (size_t j = 0; j < (size_t(1) << top); j++) {
+            place(keys, (bfs << top) + j, depth + top, bottom, next);
+        }
+    }
+
+public:
+    VebSearch(const std::vector<int>& sortedKeys) {
+        RequireSorted(sortedKeys);
+        height = 0;
+        while ((size_t(1) << height) <= sortedKeys.size()) height++;
+        maxKey = sortedKeys.empty() ? INT_MIN : sortedKeys.back();
+        if (height == 0) return;
+
+        topSize.assign(height + 1, 0);
+        bottomSize.assign(height + 1, 0);
+        topDepth.assign(height + 1, 0);
+        split(1, height);
+
+        layout.assign((size_t(1) << height) - 1, INT_MAX);
+        size_t next = 0;
+        place(sortedKeys, 1, 1, height, next);
+    }
+
+    VebSearch(NodeBST* root) : VebSearch(FrozenKeys(root)) {}
+
+    //первый ключ не меньше key или nullptr
+    const int* lowerBound(int key) const {
+        //дополнение INT_MAX не должно выдаваться за ключ
+        if (height == 0 || key > maxKey) return nullptr;
+
+        size_t position[64];
+        position[1] = 0;
+        size_t bfs = 1;
+        const int* best = nullptr;
+        for (int depth = 1;; depth++) {
+            const int* node = &layout[position[depth]];
+            bool right = *node < key;
+            best = right ? best : node;
+            if (depth == height) break;
+            bfs = 2 * bfs + right;
+            int next = depth + 1;
+            position[next] = position[topDepth[next]] + topSize[next] + (bfs & topSize[next]) * bottomSize[next];
+        }
+        return best;
+    }
+
+    bool contains(int key) const {
+        const int* found = lowerBound(key);
+        return found && *found == key;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef NODE_ARENA_H
+#define NODE_ARENA_H
+
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "BST.h"
+
+//выделение узлов NodeBST из больших непрерывных блоков: узел - сдвиг указателя
+//без обращения к malloc и без его заголовков, все дерево освобождается одним release().
+//узлы арены нельзя удалять по одному (delete, DeleteTree), а узлы, добавленные
+//в дерево обычным InsertNode, арена не освобождает
+class NodeArena {
+private:
+    std::vector<NodeBST*> blocks;
+    size_t blockNodes;    //размер следующего обычного блока
+    NodeBST* current;
+    size_t used;          //занято узлов в текущем блоке
+    size_t capacity;      //узлов в текущем блоке
+    size_t total;
+
+    void addBlock(size_t nodes) {
+        current = static_cast<NodeBST*>(::operator new(nodes * sizeof(NodeBST)));
+        blocks.push_back(current);
+        used = 0;
+        capacity = nodes;
+    }
+
+public:
+    NodeArena(size_t nodesPerBlock = 4096)
+        : blockNodes(nodesPerBlock), current(nullptr), used(0), capacity(0), total(0) {}
+
+    ~NodeArena() {
+        release();
+    }
+
+    NodeArena(const NodeArena&) = delete;
+    NodeArena& operator=(const NodeArena&) = delete;
+
+    NodeBST* create(int key) {
+        if (used == capacity) addBlock(blockNodes);
+        total++;
+        return new (current + used++) NodeBST(key);
+    }
+
+    //следующие nodes узлов будут выделены подряд в одном блоке
+    void reserve(size_t nodes) {
+        if (capacity - used < nodes) addBlock(nodes);
+    }
+
+    //освобождение всех узлов; NodeBST не требует деструктора
+    void release() {
+        for (NodeBST* block : blocks) ::operator delete(block);
+        blocks.clear();
+        current = nullptr;
+        used = capacity = total = 0;
+    }
+
+    size_t size() const {
+        return total;
+    }
+};
+
+//узел из середины отрезка [begin, end) отсортированных ключей, затем левая и правая половины:
+//узлы выделяются в прямом порядке, и левый ребенок лежит в памяти сразу за родителем
+inline NodeBST* BuildBalancedRange(const std::vector<int>& keys, size_t begin, size_t end, NodeArena& arena) {
+    if (begin == end) return nullptr;
+    size_t middle = begin + (end - begin) / 2;
+    NodeBST* node = arena.create(keys[middle]);
+    node->left = BuildBalancedRange(keys, begin, middle, arena);
+    node->right = BuildBalancedRange(keys, middle + 1, end, arena);
+    return node;
+}
+
+//идеально сбалансированное дерево из строго возрастающих ключей за O(n) одним блоком арены;
+//высота - ceil(log2(n + 1)), глубина рекурсии - столько же.
+//неупорядоченные или повторяющиеся ключи дали бы не дерево поиска - это исключение
+inline NodeBST* BuildBalancedBST(const std::vector<int>& sortedKeys, NodeArena& arena) {
+    if (std::adjacent_find(sortedKeys.begin(), sortedKeys.end(), std::greater_equal<int>()) != sortedKeys.end())
+        throw std::runtime_error("Ключи для сбалансированного дерева должны строго возрастать");
+    arena.reserve(sortedKeys.size());
+    return BuildBalancedRange(sortedKeys, 0, sortedKeys.size(), arena);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,170 @@
+#ifndef PARALLEL_RESTORE_H
+#define PARALLEL_RESTORE_H
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include "BST.h"
+
+//выполнение work(i) для i из [0, count) на threads потоках; задачи раздаются по одной
+template<typename Work>
+void ParallelFor(size_t count, unsigned threads, Work work) {
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < count; i = next++) work(i);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned t = 1; t < std::min<size_t>(threads, count); t++) pool.emplace_back(worker);
+    worker();
+    for (std::thread& t : pool) t.join();
+}
+
+//число элементов из a, которые в слиянии a и b попадают в первые diagonal результатов
+//(при равенстве первым идет элемент a, как в std::merge)
+inline size_t MergeSplit(const int* a, size_t aSize, const int* b, size_t bSize, size_t diagonal) {
+    size_t low = diagonal > bSize ? diagonal - bSize : 0;
+    size_t high = std::min(diagonal, aSize);
+    while (low < high) {
+        size_t i = low + (high - low) / 2;
+        if (a[i] <= b[diagonal - i - 1]) low = i + 1; else high = i;
+    }
+    return low;
+}
+
+//сортировка: части сортируются параллельно, затем сливаются попарно.
+//каждое слияние делится по диагоналям на независимые куски, так что
+//и последнее слияние всего массива занимает все потоки
+inline void ParallelSort(std::vector<int>& values, unsigned threads) {
+    size_t n = values.size();
+    size_t parts = threads;
+    std::vector<size_t> bounds(parts + 1);
+    for (size_t i = 0; i <= parts; i++) bounds[i] = n * i / parts;
+    ParallelFor(parts, threads, [&](size_t i) {
+        std::sort(values.begin() + bounds[i], values.begin() + bounds[i + 1]);
+    });
+
+    std::vector<int> buffer(n);
+    int* from = values.data();
+    int* to = buffer.data();
+    for (size_t width = 1; width < parts; width *= 2) {
+        size_t merges = (parts + 2 * width - 1) / (2 * width);
+        size_t pieces = std::max<size_t>(1, threads / merges);
+        ParallelFor(merges * pieces, threads, [&](size_t job) {
+            size_t first = job / pieces * 2 * width;
+            size_t piece = job % pieces;
+            size_t begin = bounds[first];
+            size_t middle = bounds[std::min(first + width, parts)];
+            size_t end = bounds[std::min(first + 2 * width, parts)];
+            const int* a = from + begin;
+            const int* b = from + middle;
+            size_t aSize = middle - begin, bSize = end - middle;
+
+            size_t lowDiagonal = (aSize + bSize) * piece / pieces;
+            size_t highDiagonal = (aSize + bSize) * (piece + 1) / pieces;
+            size_t lowA = MergeSplit(a, aSize, b, bSize, lowDiagonal);
+            size_t highA = MergeSplit(a, aSize, b, bSize, highDiagonal);
+            std::merge(a + lowA, a + highA, b + (lowDiagonal - lowA), b + (highDiagonal - highA), to + begin + lowDiagonal);
+        });
+        std::swap(from, to);
+    }
+    if (from != values.data()) std::copy(from, from + n, values.data());
+}
+
+//часть дерева для параллельного восстановления: целое поддерево ниже среза
+//или один узел над срезом; offset - место первого ключа части в порядке inorder
+struct RestorePart {
+    NodeBST* node;
+    bool subtree;
+    size_t size;
+    size_t offset;
+};
+
+//части в порядке inorder: узлы до глубины cutDepth по одному, глубже - поддеревьями
+inline void SplitForRestore(NodeBST* node, int depth, int cutDepth, std::vector<RestorePart>& parts) {
+    if (!node) return;
+    if (depth == cutDepth) {
+        parts.push_back({node, true, 0, 0});
+        return;
+    }
+    SplitForRestore(node->left, depth + 1, cutDepth, parts);
+    parts.push_back({node, false, 1, 0});
+    SplitForRestore(node->right, depth + 1, cutDepth, parts);
+}
+
+//inorder-обход поддерева со стеком в куче: глубина поддерева не ограничена стеком вызовов
+template<typename Visit>
+void StackInorder(NodeBST* root, Visit visit) {
+    std::vector<NodeBST*> stack;
+    NodeBST* node = root;
+    while (node || !stack.empty()) {
+        while (node) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        visit(node);
+        node = node->right;
+    }
+}
+
+//параллельное восстановление BST в общем случае (много ключей не на своих местах).
+//дерево режется на глубине log2(threads) + 3; размеры поддеревьев под срезом
+//считаются параллельно и дают каждому поддереву его место в общем массиве ключей,
+//затем параллельно идут сбор ключей, сортировка и запись обратно по тем же местам.
+//результат совпадает с RestoreBST. ускорение зависит от формы дерева: вырожденное
+//дерево дает одно большое поддерево и выполняется почти последовательно.
+//при threads <= 1 сначала пробуется обмен двух узлов (RecoverSwappedNodes), затем тот же
+//конвейер в одном потоке: рекурсивный RestoreBST переполнил бы стек на вырожденном дереве.
+//threads = 0 - по числу ядер
+inline NodeBST* ParallelRestoreBST(NodeBST* root, unsigned threads = 0) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    if (!root) return root;
+    if (threads <= 1 && RecoverSwappedNodes(root)) return root;
+
+    int cutDepth = 3;
+    while ((1u << (cutDepth - 3)) < threads) cutDepth++;
+    std::vector<RestorePart> parts;
+    SplitForRestore(root, 0, cutDepth, parts);
+
+    //1.размеры поддеревьев и их места в порядке inorder
+    ParallelFor(parts.size(), threads, [&](size_t i) {
+        if (!parts[i].subtree) return;
+        size_t size = 0;
+        StackInorder(parts[i].node, [&](NodeBST*) { size++; });
+        parts[i].size = size;
+    });
+    size_t total = 0;
+    for (RestorePart& part : parts) {
+        part.offset = total;
+        total += part.size;
+    }
+
+    //2.сбор ключей в заранее выделенный массив
+    std::vector<int> values(total);
+    ParallelFor(parts.size(), threads, [&](size_t i) {
+        int* out = values.data() + parts[i].offset;
+        if (parts[i].subtree)
+            StackInorder(parts[i].node, [&](NodeBST* node) { *out++ = node->key; });
+        else
+            *out = parts[i].node->key;
+    });
+
+    //3.сортировка
+    ParallelSort(values, threads);
+
+    //4.запись обратно по тем же местам
+    ParallelFor(parts.size(), threads, [&](size_t i) {
+        const int* in = values.data() + parts[i].offset;
+        if (parts[i].subtree)
+            StackInorder(parts[i].node, [&](NodeBST* node) { node->key = *in++; });
+        else
+            parts[i].node->key = *in;
+    });
+
+    return root;
+}
+
+#endif
\ No newline at end of file
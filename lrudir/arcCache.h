@@ -0,0 +1,122 @@
+#ifndef ARC_CACHE_H
+#define ARC_CACHE_H
+
+#include <algorithm>
+#include "cachePolicy.h"
+#include "slotLists.h"
+
+//адаптивный кэш ARC (Megiddo, Modha): T1 - ключи, встреченные один раз недавно,
+//T2 - встреченные хотя бы дважды. B1 и B2 - "призраки" ключей, вытесненных из T1 и T2
+//(только ключи, без значений). попадание в B1 увеличивает целевой размер T1 (target),
+//попадание в B2 - уменьшает, так кэш сам выбирает баланс давности и частоты
+class ARCCache : public CachePolicy {
+private:
+    static constexpr int32_t NONE = SlotLists::NONE;
+
+    enum ListId {
+        T1 = 0,
+        T2 = 1,
+        B1 = 2,
+        B2 = 3
+    };
+
+    int capacity;
+    int target; //желаемый размер T1
+    SlotLists nodes;
+    SlotTable table; //ключ -> узел во всех четырех списках
+
+    void dropNode(int32_t node) {
+        nodes.unlink(node);
+        table.erase(nodes[node].key);
+        nodes.release(node);
+    }
+
+    //вытеснение из T1 или T2 в соответствующий список призраков (если кэш заполнен)
+    void replace(bool hitInB2) {
+        if (size() < capacity) {
+            return;
+        }
+        int t1 = nodes.size(T1);
+        bool fromT1 = t1 > 0 && (t1 > target || (hitInB2 && t1 == target) || nodes.size(T2) == 0);
+        int32_t victim = nodes.back(fromT1 ? T1 : T2);
+        nodes.moveToFront(victim, fromT1 ? B1 : B2);
+    }
+
+protected:
+    int lookup(int key) override {
+        int32_t node = table.find(key);
+        if (node == NONE || nodes[node].list >= B1) {
+            return -1;
+        }
+        nodes.moveToFront(node, T2);
+        return nodes[node].value;
+    }
+
+    void store(int key, int value) override {
+        int32_t node = table.find(key);
+        if (node != NONE && nodes[node].list <= T2) {
+            nodes[node].value = value;
+            nodes.moveToFront(node, T2);
+            return;
+        }
+
+        if (node != NONE) {
+            //ключ среди призраков: сдвигаем баланс в пользу списка, который его потерял
+            bool inB2 = nodes[node].list == B2;
+            if (inB2) {
+                target = std::max(0, target - std::max(nodes.size(B1) / nodes.size(B2), 1));
+            } else {
+                target = std::min(capacity, target + std::max(nodes.size(B2) / nodes.size(B1), 1));
+            }
+            replace(inB2);
+            nodes[node].value = value;
+            nodes.moveToFront(node, T2);
+            return;
+        }
+
+        int l1 = nodes.size(T1) + nodes.size(B1);
+        int total = l1 + nodes.size(T2) + nodes.size(B2);
+        if (l1 == capacity) {
+            if (nodes.size(T1) < capacity) {
+                dropNode(nodes.back(B1));
+                replace(false);
+            } else {
+                dropNode(nodes.back(T1));
+            }
+        } else if (total >= capacity) {
+            if (total == 2 * capacity) {
+                dropNode(nodes.back(B2));
+            }
+            replace(false);
+        }
+
+        node = nodes.allocate(key, value);
+        table.insert(key, node);
+        nodes.pushFront(node, T1);
+    }
+
+    bool remove(int key) override {
+        int32_t node = table.find(key);
+        if (node == NONE) {
+            return false;
+        }
+        bool resident = nodes[node].list <= T2;
+        dropNode(node);
+        return resident;
+    }
+
+public:
+    //узлов 2 * capacity: до capacity в кэше и столько же призраков
+    ARCCache(int cap)
+        : capacity(cap > 0 ? cap : 1), target(0), nodes(2 * capacity, 4), table(2 * capacity) {}
+
+    const char* name() const override {
+        return "ARC";
+    }
+
+    int size() const override {
+        return nodes.size(T1) + nodes.size(T2);
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef CACHE_POLICIES_H
+#define CACHE_POLICIES_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include "cachePolicy.h"
+#include "lru.h"
+#include "indexLru.h"
+#include "tinyLfu.h"
+#include "arcCache.h"
+#include "twoQCache.h"
+
+//имена политик, которые умеет создавать createCachePolicy
+inline std::vector<std::string> cachePolicyNames() {
+    return {"list", "lru", "tinylfu", "arc", "2q"};
+}
+
+//создание политики по имени - чтобы выбирать политику по результатам замеров
+inline std::unique_ptr<CachePolicy> createCachePolicy(const std::string& name, int capacity) {
+    if (name == "list") {
+        return std::unique_ptr<CachePolicy>(new CachePolicyAdapter<LRUCache>(capacity, "LRUCache"));
+    }
+    if (name == "lru") {
+        return std::unique_ptr<CachePolicy>(new CachePolicyAdapter<IndexLRUCache>(capacity, "LRU"));
+    }
+    if (name == "tinylfu") {
+        return std::unique_ptr<CachePolicy>(new CachePolicyAdapter<TinyLFUCache>(capacity, "W-TinyLFU"));
+    }
+    if (name == "arc") {
+        return std::unique_ptr<CachePolicy>(new ARCCache(capacity));
+    }
+    if (name == "2q") {
+        return std::unique_ptr<CachePolicy>(new TwoQCache(capacity));
+    }
+    throw std::runtime_error("Неизвестная политика кэша: " + name);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef CACHE_POLICY_H
+#define CACHE_POLICY_H
+
+//счетчики обращений к кэшу
+struct CacheStats {
+    long long hits;
+    long long misses;
+    long long sets;
+    long long erases;
+
+    double hitRatio() const {
+        return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses);
+    }
+};
+
+//общий интерфейс политик вытеснения: get/set/erase и статистика.
+//get, как и в LRUCache, возвращает -1 при промахе
+class CachePolicy {
+protected:
+    CacheStats counters;
+
+    virtual int lookup(int key) = 0;
+    virtual void store(int key, int value) = 0;
+    virtual bool remove(int key) = 0;
+
+public:
+    CachePolicy() : counters{0, 0, 0, 0} {}
+    virtual ~CachePolicy() {}
+
+    virtual const char* name() const = 0;
+    virtual int size() const = 0;
+
+    int get(int key) {
+        int value = lookup(key);
+        if (value == -1) {
+            counters.misses++;
+        } else {
+            counters.hits++;
+        }
+        return value;
+    }
+
+    void set(int key, int value) {
+        counters.sets++;
+        store(key, value);
+    }
+
+    //true, если ключ был в кэше
+    bool erase(int key) {
+        bool removed = remove(key);
+        if (removed) counters.erases++;
+        return removed;
+    }
+
+    const CacheStats& stats() const {
+        return counters;
+    }
+
+    void resetStats() {
+        counters = CacheStats{0, 0, 0, 0};
+    }
+};
+
+//обертка над готовым кэшем с методами get/set/erase/size
+template<typename Cache>
+class CachePolicyAdapter : public CachePolicy {
+private:
+    Cache cache;
+    const char* policyName;
+
+protected:
+    int lookup(int key) override {
+        return cache.get(key);
+    }
+
+    void store(int key, int value) override {
+        cache.set(key, value);
+    }
+
+    bool remove(int key) override {
+        return cache.erase(key);
+    }
+
+public:
+    CachePolicyAdapter(int capacity, const char* name) : cache(capacity), policyName(name) {}
+
+    const char* name() const override {
+        return policyName;
+    }
+
+    int size() const override {
+        return cache.size();
+    }
+};
+
+#endif
\ No newline at end of file
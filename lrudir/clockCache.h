@@ -0,0 +1,284 @@
+#ifndef CLOCK_CACHE_H
+#define CLOCK_CACHE_H
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+#include "slotTable.h"
+
+//один сегмент кэша CLOCK без блокировок: попадание только ставит бит обращения,
+//стрелка при вытеснении обходит ячейки по кругу и дает второй шанс отмеченным.
+//режим CLOCK-Pro делит ячейки на горячие и холодные и помнит недавно вытесненные
+//холодные ключи: однократные обращения (сканы) не вытесняют горячие ключи.
+//бит обращения атомарный: find и get можно вызывать параллельно под блокировкой на чтение
+class ClockSegment {
+private:
+    static constexpr int32_t NONE = SlotTable::NONE;
+
+    enum SlotState : uint8_t {
+        COLD = 0,      //холодный, испытательный срок окончен
+        COLD_TEST = 1, //холодный на испытательном сроке
+        HOT = 2
+    };
+
+    //кольцо ячеек на индексах: стрелка указывает на следующую проверяемую
+    struct Ring {
+        int32_t hand;
+        int size;
+    };
+
+    int capacity;
+    int count;
+    int hand;
+    bool clockPro;
+    std::vector<int> keys;
+    std::vector<int> values;
+    std::unique_ptr<std::atomic<uint8_t>[]> referenced;
+    SlotTable table;
+
+    //CLOCK-Pro: холодные и горячие ячейки обходятся разными стрелками,
+    //горячих не больше capacity - coldTarget, coldTarget подстраивается
+    std::vector<uint8_t> states;
+    std::vector<int32_t> prev;
+    std::vector<int32_t> next;
+    Ring coldRing;
+    Ring hotRing;
+    int coldTarget;
+    int minCold;
+    //вытесненные ключи на испытательном сроке: кольцо FIFO и индекс по ключу
+    std::vector<int> ghosts;
+    int ghostHead;
+    int ghostCount;
+    SlotTable ghostTable;
+
+    //вставка за стрелкой: новая ячейка будет проверена последней
+    void ringInsert(Ring& ring, int32_t slot) {
+        if (ring.hand == NONE) {
+            prev[slot] = next[slot] = slot;
+            ring.hand = slot;
+        } else {
+            int32_t before = prev[ring.hand];
+            prev[slot] = before;
+            next[slot] = ring.hand;
+            next[before] = slot;
+            prev[ring.hand] = slot;
+        }
+        ring.size++;
+    }
+
+    void ringRemove(Ring& ring, int32_t slot) {
+        if (next[slot] == slot) {
+            ring.hand = NONE;
+        } else {
+            next[prev[slot]] = next[slot];
+            prev[next[slot]] = prev[slot];
+            if (ring.hand == slot) ring.hand = next[slot];
+        }
+        ring.size--;
+    }
+
+    //ключ вытеснен на испытательном сроке: если он вернется, станет горячим
+    void addGhost(int key) {
+        int position = (ghostHead + ghostCount) % capacity;
+        if (ghostCount == capacity) {
+            //самый старый призрак не дождался повторного обращения: холодных нужно меньше.
+            //ячейка кольца могла устареть, если ключ уже вернулся в кэш
+            if (ghostTable.find(ghosts[ghostHead]) == ghostHead) {
+                ghostTable.erase(ghosts[ghostHead]);
+                if (coldTarget > minCold) coldTarget--;
+            }
+            ghostHead = (ghostHead + 1) % capacity;
+            ghostCount--;
+        }
+        ghosts[position] = key;
+        ghostTable.insert(key, position);
+        ghostCount++;
+    }
+
+    //горячая стрелка: первый неиспользуемый горячий ключ остывает
+    void coolDown() {
+        while (true) {
+            int32_t slot = hotRing.hand;
+            hotRing.hand = next[slot];
+            if (referenced[slot].exchange(0, std::memory_order_relaxed) != 0) {
+                continue;
+            }
+            ringRemove(hotRing, slot);
+            states[slot] = COLD;
+            ringInsert(coldRing, slot);
+            return;
+        }
+    }
+
+    //CLOCK-Pro: холодная стрелка до первого неиспользуемого холодного ключа
+    int32_t evictPro() {
+        while (true) {
+            int32_t slot = coldRing.hand;
+            if (referenced[slot].exchange(0, std::memory_order_relaxed) == 0) {
+                ringRemove(coldRing, slot);
+                if (states[slot] == COLD_TEST) {
+                    addGhost(keys[slot]);
+                }
+                return slot;
+            }
+
+            if (states[slot] == COLD) {
+                //второе обращение даст ключу испытательный срок
+                states[slot] = COLD_TEST;
+                coldRing.hand = next[slot];
+                continue;
+            }
+
+            //повторное обращение на испытательном сроке - ключ становится горячим
+            ringRemove(coldRing, slot);
+            states[slot] = HOT;
+            ringInsert(hotRing, slot);
+            while (hotRing.size > capacity - coldTarget) {
+                coolDown();
+            }
+        }
+    }
+
+    //CLOCK: стрелка дает второй шанс ключам с битом обращения
+    int32_t evictClock() {
+        while (true) {
+            int32_t slot = hand;
+            hand = (hand + 1) % capacity;
+            if (referenced[slot].exchange(0, std::memory_order_relaxed) == 0) {
+                return slot;
+            }
+        }
+    }
+
+public:
+    ClockSegment(int cap, bool pro = false)
+        : capacity(cap > 0 ? cap : 1), count(0), hand(0), clockPro(pro),
+          keys(capacity), values(capacity), referenced(new std::atomic<uint8_t>[capacity]), table(capacity),
+          states(pro ? capacity : 0), prev(pro ? capacity : 0), next(pro ? capacity : 0),
+          coldRing{NONE, 0}, hotRing{NONE, 0},
+          ghosts(pro ? capacity : 0), ghostHead(0), ghostCount(0), ghostTable(pro ? capacity : 1) {
+        for (int i = 0; i < capacity; i++) {
+            referenced[i].store(0, std::memory_order_relaxed);
+        }
+        //холодным всегда остается хотя бы 1% емкости - иначе новые ключи не успеют закрепиться
+        minCold = std::max(1, capacity / 100);
+        coldTarget = minCold;
+    }
+
+    //попадание: только ослабленная запись бита обращения
+    int get(int key) {
+        int32_t slot = table.find(key);
+        if (slot == NONE) {
+            return -1;
+        }
+        referenced[slot].store(1, std::memory_order_relaxed);
+        return values[slot];
+    }
+
+    void set(int key, int value) {
+        int32_t slot = table.find(key);
+        if (slot != NONE) {
+            values[slot] = value;
+            referenced[slot].store(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (count < capacity) {
+            slot = count++;
+        } else {
+            slot = clockPro ? evictPro() : evictClock();
+            table.erase(keys[slot]);
+        }
+
+        keys[slot] = key;
+        values[slot] = value;
+        referenced[slot].store(0, std::memory_order_relaxed);
+        table.insert(key, slot);
+
+        if (clockPro) {
+            if (ghostTable.find(key) != NONE) {
+                //вернулся в пределах испытательного срока: холодных нужно больше
+                ghostTable.erase(key);
+                if (coldTarget < capacity - 1) coldTarget++;
+                states[slot] = HOT;
+                ringInsert(hotRing, slot);
+                while (hotRing.size > capacity - coldTarget) {
+                    coolDown();
+                }
+            } else {
+                states[slot] = COLD_TEST;
+                ringInsert(coldRing, slot);
+            }
+        }
+    }
+
+    int size() const {
+        return count;
+    }
+};
+
+//потокобезопасный кэш CLOCK: ключи распределяются по сегментам, как в ShardedLRUCache.
+//get берет блокировку своего сегмента только на чтение, поэтому читатели не ждут друг друга,
+//а атомарные операции над словом блокировки расходятся по разным кэш-линиям.
+//вытеснение идет внутри сегмента, поэтому при shardCount > 1 политика приближенная
+class ClockCache {
+private:
+    //выравнивание по кэш-линии: слова блокировок разных сегментов не делят линию
+    struct alignas(64) Shard {
+        std::shared_mutex lock;
+        ClockSegment segment;
+
+        Shard(int capacity, bool pro) : segment(capacity, pro) {}
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    uint32_t shardMask;
+
+    Shard& shardFor(int key) {
+        uint32_t h = static_cast<uint32_t>(key) * 0x85EBCA6BU;
+        h ^= h >> 13;
+        return *shards[(h >> 16) & shardMask];
+    }
+
+public:
+    ClockCache(int capacity, bool pro = false, int shardCount = 16) {
+        //число сегментов - степень двойки, не больше емкости; емкость делится точно
+        capacity = std::max(1, capacity);
+        uint32_t count = 1;
+        while (count < static_cast<uint32_t>(shardCount) && count * 2 <= static_cast<uint32_t>(capacity)) count <<= 1;
+        shardMask = count - 1;
+
+        int base = capacity / static_cast<int>(count);
+        int extra = capacity % static_cast<int>(count);
+        for (int i = 0; i < static_cast<int>(count); i++) {
+            shards.push_back(std::make_unique<Shard>(base + (i < extra ? 1 : 0), pro));
+        }
+    }
+
+    int get(int key) {
+        Shard& shard = shardFor(key);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        return shard.segment.get(key);
+    }
+
+    void set(int key, int value) {
+        Shard& shard = shardFor(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        shard.segment.set(key, value);
+    }
+
+    int size() {
+        int total = 0;
+        for (auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard(shard->lock);
+            total += shard->segment.size();
+        }
+        return total;
+    }
+};
+
+#endif
\ No newline at end of file
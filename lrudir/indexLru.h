@@ -0,0 +1,169 @@
+#ifndef INDEX_LRU_H
+#define INDEX_LRU_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "slotTable.h"
+
+//LRU-кэш на одном заранее выделенном массиве ячеек.
+//порядок использования - двусвязный список на индексах prev/next,
+//ключ -> ячейка - таблица с открытой адресацией SlotTable.
+//после конструктора ни get, ни set не выделяют память
+class IndexLRUCache {
+public:
+    struct Slot {
+        int key;
+        int value;
+        int32_t prev;
+        int32_t next;
+    };
+
+    //копия занятых ячеек для снимка: порядок по ссылкам восстанавливается уже вне кэша
+    struct Image {
+        std::vector<Slot> slots;
+        int32_t head;
+    };
+
+private:
+    static constexpr int32_t NONE = SlotTable::NONE;
+
+    int capacity;
+    int count;
+    int32_t head; //самый недавно использованный
+    int32_t tail; //кандидат на вытеснение
+    std::vector<Slot> slots;
+    SlotTable table;
+
+    void unlink(int32_t slot) {
+        Slot& s = slots[slot];
+        if (s.prev != NONE) slots[s.prev].next = s.next; else head = s.next;
+        if (s.next != NONE) slots[s.next].prev = s.prev; else tail = s.prev;
+    }
+
+    void pushFront(int32_t slot) {
+        slots[slot].prev = NONE;
+        slots[slot].next = head;
+        if (head != NONE) slots[head].prev = slot;
+        head = slot;
+        if (tail == NONE) tail = slot;
+    }
+
+    void moveToFront(int32_t slot) {
+        if (slot == head) return;
+        unlink(slot);
+        pushFront(slot);
+    }
+
+public:
+    IndexLRUCache(int cap)
+        : capacity(cap > 0 ? cap : 1), count(0), head(NONE), tail(NONE), slots(capacity), table(capacity) {}
+
+    int get(int key) {
+        int32_t slot = table.find(key);
+        if (slot == NONE) {
+            return -1;
+        }
+        moveToFront(slot);
+        return slots[slot].value;
+    }
+
+    //чтение без изменения порядка (можно вызывать параллельно из нескольких потоков)
+    int peek(int key) const {
+        int32_t slot = table.find(key);
+        return slot == NONE ? -1 : slots[slot].value;
+    }
+
+    //отложенное обновление порядка: ключ мог быть уже вытеснен
+    void touch(int key) {
+        int32_t slot = table.find(key);
+        if (slot != NONE) {
+            moveToFront(slot);
+        }
+    }
+
+    void set(int key, int value) {
+        int32_t slot = table.find(key);
+        if (slot != NONE) {
+            slots[slot].value = value;
+            moveToFront(slot);
+            return;
+        }
+
+        if (count < capacity) {
+            slot = count++;
+        } else {
+            //вытесняемая ячейка сразу переходит новому ключу
+            slot = tail;
+            table.erase(slots[slot].key);
+            unlink(slot);
+        }
+
+        slots[slot].key = key;
+        slots[slot].value = value;
+        table.insert(key, slot);
+        pushFront(slot);
+    }
+
+    //удаление ключа; ячейка возвращается в пул, последняя занятая переезжает на ее место
+    bool erase(int key) {
+        int32_t slot = table.find(key);
+        if (slot == NONE) {
+            return false;
+        }
+        table.erase(key);
+        unlink(slot);
+
+        int32_t last = --count;
+        if (slot != last) {
+            slots[slot] = slots[last];
+            if (slots[slot].prev != NONE) slots[slots[slot].prev].next = slot; else head = slot;
+            if (slots[slot].next != NONE) slots[slots[slot].next].prev = slot; else tail = slot;
+            table.insert(slots[slot].key, slot);
+        }
+        return true;
+    }
+
+    //снимок состояния: одно копирование непрерывного массива ячеек
+    Image image() const {
+        return Image{std::vector<Slot>(slots.begin(), slots.begin() + count), head};
+    }
+
+    //добавление ключа самым давним, если есть место (для загрузки снимка)
+    bool appendOldest(int key, int value) {
+        if (count == capacity || !table.tryInsert(key, count)) {
+            return false;
+        }
+        int32_t slot = count++;
+        slots[slot].key = key;
+        slots[slot].value = value;
+        slots[slot].prev = tail;
+        slots[slot].next = NONE;
+        if (tail != NONE) slots[tail].next = slot; else head = slot;
+        tail = slot;
+        return true;
+    }
+
+    //загрузка пар (ключ, значение), упорядоченных от самого недавнего: ячейки заполняются
+    //подряд, ссылки списка проставляются сразу - без вытеснений и перестановок
+    void bulkLoad(const int32_t* pairs, size_t pairCount) {
+        //позиции в таблице запрашиваются на несколько пар вперед: загрузка упирается в промахи кэша
+        const size_t lookahead = 16;
+        for (size_t i = 0; i < pairCount && count < capacity; i++) {
+            if (i + lookahead < pairCount) {
+                table.prefetch(pairs[2 * (i + lookahead)]);
+            }
+            appendOldest(pairs[2 * i], pairs[2 * i + 1]);
+        }
+    }
+
+    int size() const {
+        return count;
+    }
+
+    int maxSize() const {
+        return capacity;
+    }
+};
+
+#endif
\ No newline at end of file
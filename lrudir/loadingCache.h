@@ -0,0 +1,155 @@
+#ifndef LOADING_CACHE_H
+#define LOADING_CACHE_H
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include "ttlLru.h"
+
+//потокобезопасный кэш с загрузкой при промахе (single-flight): одновременные промахи
+//по одному ключу ждут одну загрузку и получают ее результат, а не нагружают источник.
+//ключи живут ttl миллисекунд (0 - бессрочно); если при попадании до истечения осталось
+//меньше refreshAhead, ключ перезагружается в фоне, а get сразу возвращает старое значение
+class LoadingCache {
+public:
+    typedef std::function<int(int)> Loader;
+
+private:
+    std::mutex lock;
+    TimedLRUCache cache;
+    std::unordered_map<int, std::shared_future<int>> inFlight;
+    std::vector<std::future<void>> refreshes;
+    uint64_t ttl;
+    uint64_t refreshAhead;
+    std::chrono::steady_clock::time_point started;
+
+    std::atomic<long long> loads;     //вызовы источника
+    std::atomic<long long> coalesced; //промахи, дождавшиеся чужой загрузки
+    std::atomic<long long> refreshed; //фоновые обновления
+
+    //часы кэша - миллисекунды от создания; вызывается под блокировкой
+    void syncClock() {
+        uint64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - started).count();
+        if (now > cache.now()) {
+            cache.advance(now);
+        }
+    }
+
+    //загрузка с публикацией результата; promise уже зарегистрирован в inFlight
+    int runLoad(int key, const Loader& loader, std::promise<int>& result) {
+        int value;
+        try {
+            loads++;
+            value = loader(key);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(lock);
+            inFlight.erase(key);
+            result.set_exception(std::current_exception());
+            throw;
+        }
+
+        {
+            //значение попадает в кэш раньше, чем загрузка перестает быть "в полете":
+            //пришедший позже поток найдет его в кэше
+            std::lock_guard<std::mutex> guard(lock);
+            syncClock();
+            cache.set(key, value, ttl);
+            inFlight.erase(key);
+        }
+        result.set_value(value);
+        return value;
+    }
+
+    //фоновое обновление ключа; вызывается под блокировкой
+    void startRefresh(int key, const Loader& loader) {
+        auto result = std::make_shared<std::promise<int>>();
+        inFlight.emplace(key, result->get_future().share());
+        refreshed++;
+
+        //завершившиеся фоновые задачи больше не нужны
+        for (size_t i = 0; i < refreshes.size();) {
+            if (refreshes[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                refreshes[i] = std::move(refreshes.back());
+                refreshes.pop_back();
+            } else {
+                i++;
+            }
+        }
+
+        refreshes.push_back(std::async(std::launch::async, [this, key, loader, result]() {
+            try {
+                runLoad(key, loader, *result);
+            } catch (...) {
+                //ошибка фонового обновления не страшна: старое значение доживет до истечения
+            }
+        }));
+    }
+
+public:
+    LoadingCache(int capacity, uint64_t ttlMs = 0, uint64_t refreshAheadMs = 0)
+        : cache(capacity), ttl(ttlMs), refreshAhead(refreshAheadMs),
+          started(std::chrono::steady_clock::now()), loads(0), coalesced(0), refreshed(0) {}
+
+    //дожидаемся фоновых обновлений: они обращаются к кэшу
+    ~LoadingCache() {
+        std::vector<std::future<void>> pending;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            pending.swap(refreshes);
+        }
+        for (std::future<void>& task : pending) {
+            task.wait();
+        }
+    }
+
+    //значение из кэша или результат загрузки; исключение загрузчика получают все ожидающие
+    int getOrLoad(int key, const Loader& loader) {
+        std::shared_future<int> pending;
+        std::promise<int> result;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            syncClock();
+            int value = cache.get(key);
+            if (value != -1) {
+                uint64_t expiresAt = cache.expiresAt(key);
+                if (refreshAhead > 0 && expiresAt > 0 && expiresAt - cache.now() <= refreshAhead &&
+                    inFlight.find(key) == inFlight.end()) {
+                    startRefresh(key, loader);
+                }
+                return value;
+            }
+
+            auto it = inFlight.find(key);
+            if (it != inFlight.end()) {
+                pending = it->second;
+            } else {
+                inFlight.emplace(key, result.get_future().share());
+            }
+        }
+
+        if (pending.valid()) {
+            coalesced++;
+            return pending.get();
+        }
+        return runLoad(key, loader, result);
+    }
+
+    long long loadCount() const {
+        return loads;
+    }
+
+    long long coalescedCount() const {
+        return coalesced;
+    }
+
+    long long refreshCount() const {
+        return refreshed;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -1,54 +1,11 @@
 #include <iostream>
-#include <unordered_map>
-#include <list>
 #include <string>
 #include <sstream>
 #include <vector>
+#include "lru.h"
 
 using namespace std;
 
-class LRUCache {
-private:
-    int capacity;
-    list<pair<int, int>> cache;
-    unordered_map<int, list<pair<int, int>>::iterator> keyMap;
-
-public:
-    LRUCache(int cap) {
-        capacity = cap;
-    }
-
-    int get(int key) {
-        if (keyMap.find(key) == keyMap.end()) {
-            return -1;
-        }
-        
-        auto it = keyMap[key];
-        int value = it->second;
-        cache.erase(it);
-        cache.push_front({key, value});
-        keyMap[key] = cache.begin();
-        
-        return value;
-    }
-
-    void set(int key, int value) {
-        if (keyMap.find(key) != keyMap.end()) {
-            auto it = keyMap[key];
-            cache.erase(it);
-        }
-        else if (cache.size() == capacity) {
-            auto last = cache.back();
-            int lastKey = last.first;
-            keyMap.erase(lastKey);
-            cache.pop_back();
-        }
-        
-        cache.push_front({key, value});
-        keyMap[key] = cache.begin();
-    }
-};
-
 int main() {
     
     int cap, Q;
@@ -0,0 +1,63 @@
+#ifndef LRU_H
+#define LRU_H
+
+#include <unordered_map>
+#include <list>
+
+class LRUCache {
+private:
+    int capacity;
+    std::list<std::pair<int, int>> cache;
+    std::unordered_map<int, std::list<std::pair<int, int>>::iterator> keyMap;
+
+public:
+    LRUCache(int cap) {
+        capacity = cap;
+    }
+
+    int get(int key) {
+        if (keyMap.find(key) == keyMap.end()) {
+            return -1;
+        }
+        
+        auto it = keyMap[key];
+        int value = it->second;
+        cache.erase(it);
+        cache.push_front({key, value});
+        keyMap[key] = cache.begin();
+        
+        return value;
+    }
+
+    void set(int key, int value) {
+        if (keyMap.find(key) != keyMap.end()) {
+            auto it = keyMap[key];
+            cache.erase(it);
+        }
+        else if (cache.size() == capacity) {
+            auto last = cache.back();
+            int lastKey = last.first;
+            keyMap.erase(lastKey);
+            cache.pop_back();
+        }
+        
+        cache.push_front({key, value});
+        keyMap[key] = cache.begin();
+    }
+
+    bool erase(int key) {
+        auto found = keyMap.find(key);
+        if (found == keyMap.end()) {
+            return false;
+        }
+        cache.erase(found->second);
+        keyMap.erase(found);
+        return true;
+    }
+
+    int size() const {
+        return cache.size();
+    }
+};
+
+#endif
\ No newline at end of file
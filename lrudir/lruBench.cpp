@@ -0,0 +1,690 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <list>
+#include <fstream>
+#include <cstdio>
+#include <unordered_map>
+#include "lru.h"
+#include "indexLru.h"
+#include "shardedLru.h"
+#include "clockCache.h"
+#include "tinyLfu.h"
+#include "cachePolicies.h"
+#include "ttlLru.h"
+#include "weightedLru.h"
+#include "loadingCache.h"
+#include "lruSnapshot.h"
+#include "workload.h"
+
+using namespace std;
+using namespace std::chrono;
+
+//поток запросов: GET, при промахе - SET того же ключа
+template<typename Cache>
+double replayGetOrSet(Cache& cache, const vector<int>& keys, int& hits) {
+    hits = 0;
+    auto start = high_resolution_clock::now();
+    for (int key : keys) {
+        if (cache.get(key) != -1) {
+            hits++;
+        } else {
+            cache.set(key, key);
+        }
+    }
+    return duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+}
+
+//дополнение строки пробелами до width символов (setw считает байты, а не буквы UTF-8)
+string padRight(const string& text, int width) {
+    int letters = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) letters++;
+    }
+    return text + string(max(0, width - letters), ' ');
+}
+
+//LRUCache на std::list против кэша на массиве ячеек
+void benchmarkIndexLru() {
+    const int capacities[] = {1000, 10000, 100000, 1000000, 10000000};
+    const int operations = 4000000;
+    mt19937 gen(42);
+
+    cout << "\nLRUCache (std::list + unordered_map) ПРОТИВ IndexLRUCache\n";
+    cout << "┌──────────┬──────────┬──────────────┬──────────────┬──────────────┬──────────────┬───────────┐\n";
+    cout << "│ емкость  │ попадания│ list, с      │ index, с     │ list, Mops/s │ index, Mops/s│ ускорение │\n";
+    cout << "├──────────┼──────────┼──────────────┼──────────────┼──────────────┼──────────────┼───────────┤\n";
+
+    for (int capacity : capacities) {
+        //ключей вдвое больше емкости: около половины запросов - промахи с вытеснением
+        uniform_int_distribution<int> dist(0, 2 * capacity - 1);
+        vector<int> keys(operations);
+        for (int& key : keys) key = dist(gen);
+
+        LRUCache listCache(capacity);
+        IndexLRUCache indexCache(capacity);
+        for (int i = 0; i < capacity; i++) {
+            listCache.set(dist(gen), i);
+        }
+        for (int i = 0; i < capacity; i++) {
+            indexCache.set(dist(gen), i);
+        }
+
+        int listHits, indexHits;
+        double listTime = replayGetOrSet(listCache, keys, listHits);
+        double indexTime = replayGetOrSet(indexCache, keys, indexHits);
+
+        cout << "│ " << setw(8) << capacity << " │ "
+             << fixed << setprecision(1) << setw(7) << 100.0 * indexHits / operations << "% │ "
+             << setprecision(6) << setw(12) << listTime << " │ "
+             << setw(12) << indexTime << " │ "
+             << setprecision(2) << setw(12) << operations / listTime / 1e6 << " │ "
+             << setw(12) << operations / indexTime / 1e6 << " │ "
+             << setw(8) << listTime / indexTime << "x │\n";
+    }
+
+    cout << "└──────────┴──────────┴──────────────┴──────────────┴──────────────┴──────────────┴───────────┘\n";
+}
+
+//LRUCache под одной общей блокировкой - то, что есть без сегментирования
+class LockedLRUCache {
+private:
+    mutex lock;
+    LRUCache cache;
+
+public:
+    LockedLRUCache(int capacity) : cache(capacity) {}
+
+    int get(int key) {
+        lock_guard<mutex> guard(lock);
+        return cache.get(key);
+    }
+
+    void set(int key, int value) {
+        lock_guard<mutex> guard(lock);
+        cache.set(key, value);
+    }
+};
+
+//запуск потоков, каждый проигрывает свою последовательность ключей; результат - Mops/s
+template<typename Cache>
+double runThreads(Cache& cache, const vector<vector<int>>& keysPerThread) {
+    vector<thread> workers;
+    auto start = high_resolution_clock::now();
+    for (const vector<int>& keys : keysPerThread) {
+        workers.emplace_back([&cache, &keys]() {
+            int hits;
+            replayGetOrSet(cache, keys, hits);
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+    double seconds = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+    size_t operations = 0;
+    for (const vector<int>& keys : keysPerThread) operations += keys.size();
+    return operations / seconds / 1e6;
+}
+
+//пропускная способность при 1-32 потоках: общая блокировка против сегментов
+void benchmarkShardedLru() {
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    const int capacity = 100000;
+    const int keySpace = 1000000;
+    const int operationsPerThread = 100000;
+    mt19937 gen(7);
+    ZipfGenerator zipf(keySpace, 0.99);
+    uniform_int_distribution<int> uniform(0, keySpace - 1);
+
+    for (int workload = 0; workload < 2; workload++) {
+        cout << "\nМНОГОПОТОЧНЫЙ LRU, " << (workload == 0 ? "равномерные ключи" : "ключи по Ципфу (alpha = 0.99)")
+             << ", Mops/s\n";
+        cout << "┌─────────┬──────────────┬──────────────┬──────────────┐\n";
+        cout << "│ потоки  │ один мьютекс │ сегменты     │ сегм.+буфер  │\n";
+        cout << "├─────────┼──────────────┼──────────────┼──────────────┤\n";
+
+        for (int threads : threadCounts) {
+            vector<vector<int>> keys(threads, vector<int>(operationsPerThread));
+            for (vector<int>& threadKeys : keys) {
+                for (int& key : threadKeys) key = workload == 0 ? uniform(gen) : zipf(gen);
+            }
+
+            LockedLRUCache locked(capacity);
+            ShardedLRUCache sharded(capacity, 64, false);
+            ShardedLRUCache buffered(capacity, 64, true);
+
+            double lockedRate = runThreads(locked, keys);
+            double shardedRate = runThreads(sharded, keys);
+            double bufferedRate = runThreads(buffered, keys);
+
+            cout << "│ " << setw(7) << threads << " │ "
+                 << fixed << setprecision(2) << setw(12) << lockedRate << " │ "
+                 << setw(12) << shardedRate << " │ "
+                 << setw(12) << bufferedRate << " │\n";
+        }
+
+        cout << "└─────────┴──────────────┴──────────────┴──────────────┘\n";
+    }
+}
+
+//доля попаданий и скорость: точный LRU, CLOCK и CLOCK-Pro (один сегмент - точная политика),
+//затем пропускная способность CLOCK при 1-32 потоках с одной блокировкой и с сегментами
+void benchmarkClock() {
+    const int capacity = 10000;
+    const int keySpace = 100000;
+    const int operations = 3000000;
+    mt19937 gen(11);
+
+    struct Workload {
+        const char* name;
+        vector<int> trace;
+    };
+    vector<Workload> workloads;
+    workloads.push_back({"Ципф 0.99", scanMixedTrace(operations, keySpace, 0.99, 0, 1, gen)});
+    workloads.push_back({"Ципф + сканы", scanMixedTrace(operations, keySpace, 0.99, 20000, 50000, gen)});
+
+    cout << "\nCLOCK И CLOCK-PRO ПРОТИВ ТОЧНОГО LRU (емкость " << capacity << ")\n";
+    cout << "┌──────────────┬────────────┬──────────┬──────────────┐\n";
+    cout << "│ трасса       │ политика   │ попадания│ Mops/s       │\n";
+    cout << "├──────────────┼────────────┼──────────┼──────────────┤\n";
+
+    for (const Workload& workload : workloads) {
+        IndexLRUCache lru(capacity);
+        ClockCache clock(capacity, false, 1);
+        ClockCache clockPro(capacity, true, 1);
+
+        int hits[3];
+        double times[3];
+        times[0] = replayGetOrSet(lru, workload.trace, hits[0]);
+        times[1] = replayGetOrSet(clock, workload.trace, hits[1]);
+        times[2] = replayGetOrSet(clockPro, workload.trace, hits[2]);
+
+        const char* names[] = {"LRU", "CLOCK", "CLOCK-Pro"};
+        for (int i = 0; i < 3; i++) {
+            cout << "│ " << padRight(i == 0 ? workload.name : "", 12) << " │ "
+                 << padRight(names[i], 10) << " │ "
+                 << fixed << setprecision(1) << setw(7) << 100.0 * hits[i] / workload.trace.size() << "% │ "
+                 << setprecision(2) << setw(12) << workload.trace.size() / times[i] / 1e6 << " │\n";
+        }
+    }
+
+    cout << "└──────────────┴────────────┴──────────┴──────────────┘\n";
+
+    const int threadCounts[] = {1, 2, 4, 8, 16, 32};
+    const int operationsPerThread = 100000;
+    ZipfGenerator zipf(keySpace, 0.99);
+
+    cout << "\nМНОГОПОТОЧНЫЙ CLOCK, ключи по Ципфу (alpha = 0.99), Mops/s\n";
+    cout << "┌─────────┬──────────────┬──────────────┬──────────────┐\n";
+    cout << "│ потоки  │ 1 сегмент    │ 64 сегмента  │ LRU+буфер    │\n";
+    cout << "├─────────┼──────────────┼──────────────┼──────────────┤\n";
+
+    for (int threads : threadCounts) {
+        vector<vector<int>> keys(threads, vector<int>(operationsPerThread));
+        for (vector<int>& threadKeys : keys) {
+            for (int& key : threadKeys) key = zipf(gen);
+        }
+
+        ClockCache single(capacity, false, 1);
+        ClockCache sharded(capacity, false, 64);
+        ShardedLRUCache buffered(capacity, 64, true);
+
+        double singleRate = runThreads(single, keys);
+        double shardedRate = runThreads(sharded, keys);
+        double bufferedRate = runThreads(buffered, keys);
+
+        cout << "│ " << setw(7) << threads << " │ "
+             << fixed << setprecision(2) << setw(12) << singleRate << " │ "
+             << setw(12) << shardedRate << " │ "
+             << setw(12) << bufferedRate << " │\n";
+    }
+
+    cout << "└─────────┴──────────────┴──────────────┴──────────────┘\n";
+}
+
+//допуск W-TinyLFU против LRU на трассах по Ципфу и со сканами
+void benchmarkTinyLfu() {
+    const int capacity = 10000;
+    const int keySpace = 200000;
+    const int operations = 3000000;
+    mt19937 gen(13);
+
+    struct Workload {
+        const char* name;
+        vector<int> trace;
+    };
+    vector<Workload> workloads;
+    workloads.push_back({"Ципф 0.8", scanMixedTrace(operations, keySpace, 0.8, 0, 1, gen)});
+    workloads.push_back({"Ципф 0.99", scanMixedTrace(operations, keySpace, 0.99, 0, 1, gen)});
+    workloads.push_back({"Ципф + сканы", scanMixedTrace(operations, keySpace, 0.99, 20000, 50000, gen)});
+
+    cout << "\nW-TINYLFU ПРОТИВ LRU (емкость " << capacity << ")\n";
+    cout << "┌──────────────┬────────────┬──────────┬──────────────┐\n";
+    cout << "│ трасса       │ политика   │ попадания│ Mops/s       │\n";
+    cout << "├──────────────┼────────────┼──────────┼──────────────┤\n";
+
+    for (const Workload& workload : workloads) {
+        IndexLRUCache lru(capacity);
+        TinyLFUCache tinyLfu(capacity);
+
+        int hits[2];
+        double times[2];
+        times[0] = replayGetOrSet(lru, workload.trace, hits[0]);
+        times[1] = replayGetOrSet(tinyLfu, workload.trace, hits[1]);
+
+        const char* names[] = {"LRU", "W-TinyLFU"};
+        for (int i = 0; i < 2; i++) {
+            cout << "│ " << padRight(i == 0 ? workload.name : "", 12) << " │ "
+                 << padRight(names[i], 10) << " │ "
+                 << fixed << setprecision(1) << setw(7) << 100.0 * hits[i] / workload.trace.size() << "% │ "
+                 << setprecision(2) << setw(12) << workload.trace.size() / times[i] / 1e6 << " │\n";
+        }
+    }
+
+    cout << "└──────────────┴────────────┴──────────┴──────────────┘\n";
+}
+
+//все политики через общий интерфейс CachePolicy на одинаковых трассах
+void benchmarkPolicies() {
+    const int capacity = 10000;
+    const int keySpace = 200000;
+    const int operations = 2000000;
+    mt19937 gen(19);
+
+    struct Workload {
+        const char* name;
+        vector<int> trace;
+    };
+    vector<Workload> workloads;
+    workloads.push_back({"Ципф 0.8", scanMixedTrace(operations, keySpace, 0.8, 0, 1, gen)});
+    workloads.push_back({"Ципф 0.99", scanMixedTrace(operations, keySpace, 0.99, 0, 1, gen)});
+    workloads.push_back({"Ципф + сканы", scanMixedTrace(operations, keySpace, 0.99, 20000, 50000, gen)});
+    //цикл чуть длиннее емкости - худший случай для LRU
+    vector<int> loop(operations);
+    for (int i = 0; i < operations; i++) loop[i] = i % (capacity + capacity / 2);
+    workloads.push_back({"цикл 1.5x", loop});
+
+    cout << "\nПОЛИТИКИ ВЫТЕСНЕНИЯ ЧЕРЕЗ CachePolicy (емкость " << capacity << ")\n";
+    cout << "┌──────────────┬────────────┬──────────┬──────────────┐\n";
+    cout << "│ трасса       │ политика   │ попадания│ Mops/s       │\n";
+    cout << "├──────────────┼────────────┼──────────┼──────────────┤\n";
+
+    for (const Workload& workload : workloads) {
+        bool first = true;
+        for (const string& policyName : cachePolicyNames()) {
+            unique_ptr<CachePolicy> policy = createCachePolicy(policyName, capacity);
+            int hits;
+            double seconds = replayGetOrSet(*policy, workload.trace, hits);
+
+            cout << "│ " << padRight(first ? workload.name : "", 12) << " │ "
+                 << padRight(policy->name(), 10) << " │ "
+                 << fixed << setprecision(1) << setw(7) << 100.0 * policy->stats().hitRatio() << "% │ "
+                 << setprecision(2) << setw(12) << workload.trace.size() / seconds / 1e6 << " │\n";
+            first = false;
+        }
+    }
+
+    cout << "└──────────────┴────────────┴──────────┴──────────────┘\n";
+}
+
+//сроки жизни на колесе таймеров: миллионы ключей со смешанными TTL
+void benchmarkTtl() {
+    const int capacities[] = {1000000, 4000000};
+    const int setsPerTick = 16;
+    //срок жизни в тиках; 0 - бессрочный ключ
+    const uint64_t ttls[] = {0, 100, 1000, 10000, 100000, 1000000};
+    mt19937 gen(23);
+
+    cout << "\nTTL НА ИЕРАРХИЧЕСКОМ КОЛЕСЕ ТАЙМЕРОВ (" << setsPerTick << " set на тик)\n";
+    cout << "┌──────────┬──────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    cout << "│ емкость  │ операций │ Mops/s       │ истекло      │ тик ср., мкс │ тик макс, мкс│\n";
+    cout << "├──────────┼──────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+
+    for (int capacity : capacities) {
+        int operations = 2 * capacity;
+        uniform_int_distribution<int> keys(0, 2 * capacity - 1);
+        uniform_int_distribution<int> ttlIndex(0, 5);
+        vector<pair<int, uint64_t>> requests(operations);
+        for (auto& request : requests) {
+            request = {keys(gen), ttls[ttlIndex(gen)]};
+        }
+
+        TimedLRUCache cache(capacity);
+        double tickTotal = 0, tickMax = 0;
+        int ticks = 0;
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < operations; i++) {
+            if (cache.get(requests[i].first) == -1) {
+                cache.set(requests[i].first, i, requests[i].second);
+            }
+            if ((i + 1) % setsPerTick == 0) {
+                auto tickStart = high_resolution_clock::now();
+                cache.advance(cache.now() + 1);
+                double tickTime = duration_cast<nanoseconds>(high_resolution_clock::now() - tickStart).count() / 1e3;
+                tickTotal += tickTime;
+                tickMax = max(tickMax, tickTime);
+                ticks++;
+            }
+        }
+        double seconds = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        cout << "│ " << setw(8) << capacity << " │ " << setw(8) << operations << " │ "
+             << fixed << setprecision(2) << setw(12) << operations / seconds / 1e6 << " │ "
+             << setw(12) << cache.expiredCount() << " │ "
+             << setprecision(3) << setw(12) << tickTotal / ticks << " │ "
+             << setw(12) << tickMax << " │\n";
+    }
+
+    cout << "└──────────┴──────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n";
+}
+
+//то, как пришлось бы делать на LRUCache со строками: list + unordered_map<string>,
+//поиск строит временную строку, get возвращает копию значения
+class StringListLRU {
+private:
+    size_t capacity;
+    size_t totalBytes;
+    list<pair<string, string>> cache;
+    unordered_map<string, list<pair<string, string>>::iterator> keyMap;
+
+public:
+    StringListLRU(size_t bytes) : capacity(bytes), totalBytes(0) {}
+
+    bool get(string_view key, string& value) {
+        auto it = keyMap.find(string(key));
+        if (it == keyMap.end()) {
+            return false;
+        }
+        cache.splice(cache.begin(), cache, it->second);
+        value = it->second->second;
+        return true;
+    }
+
+    void set(const string& key, const string& value) {
+        auto it = keyMap.find(key);
+        if (it != keyMap.end()) {
+            totalBytes -= key.size() + it->second->second.size();
+            cache.erase(it->second);
+            keyMap.erase(it);
+        }
+        cache.push_front({key, value});
+        keyMap[key] = cache.begin();
+        totalBytes += key.size() + value.size();
+        while (totalBytes > capacity) {
+            auto& last = cache.back();
+            totalBytes -= last.first.size() + last.second.size();
+            keyMap.erase(last.first);
+            cache.pop_back();
+        }
+    }
+};
+
+//строковые ключи и значения-блобы переменного размера при емкости в байтах
+void benchmarkWeighted() {
+    const int keyCount = 100000;
+    const int operations = 2000000;
+    const size_t budgets[] = {8u << 20, 64u << 20};
+    mt19937 gen(29);
+
+    //ключи лежат в одном буфере, запросы - string_view на него
+    string keyBuffer;
+    vector<pair<size_t, size_t>> keyRanges;
+    vector<string> blobs(keyCount);
+    uniform_int_distribution<int> blobSize(64, 8192);
+    for (int i = 0; i < keyCount; i++) {
+        string key = "user:" + to_string(i) + ":profile";
+        keyRanges.push_back({keyBuffer.size(), key.size()});
+        keyBuffer += key;
+        blobs[i] = string(blobSize(gen), static_cast<char>('a' + i % 26));
+    }
+    ZipfGenerator zipf(keyCount, 0.9);
+    vector<int> trace(operations);
+    for (int& id : trace) id = zipf(gen);
+
+    cout << "\nLRU С ЕМКОСТЬЮ В БАЙТАХ: string-ключи, блобы 64-8192 байт\n";
+    cout << "┌──────────┬──────────────────┬──────────┬──────────────┬──────────────┐\n";
+    cout << "│ бюджет   │ реализация       │ попадания│ Mops/s       │ записей      │\n";
+    cout << "├──────────┼──────────────────┼──────────┼──────────────┼──────────────┤\n";
+
+    for (size_t budget : budgets) {
+        StringListLRU listCache(budget);
+        long long listHits = 0;
+        string value;
+        auto start = high_resolution_clock::now();
+        for (int id : trace) {
+            string_view key(keyBuffer.data() + keyRanges[id].first, keyRanges[id].second);
+            if (listCache.get(key, value)) {
+                listHits++;
+            } else {
+                listCache.set(string(key), blobs[id]);
+            }
+        }
+        double listTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        WeightedLRUCache<string, string> weighted(budget);
+        long long weightedHits = 0;
+        start = high_resolution_clock::now();
+        for (int id : trace) {
+            string_view key(keyBuffer.data() + keyRanges[id].first, keyRanges[id].second);
+            if (weighted.get(key) != nullptr) {
+                weightedHits++;
+            } else {
+                weighted.set(string(key), blobs[id]);
+            }
+        }
+        double weightedTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        cout << "│ " << setw(5) << (budget >> 20) << " МБ │ " << padRight("list + копия", 16) << " │ "
+             << fixed << setprecision(1) << setw(7) << 100.0 * listHits / operations << "% │ "
+             << setprecision(2) << setw(12) << operations / listTime / 1e6 << " │ "
+             << setw(12) << "-" << " │\n";
+        cout << "│ " << setw(8) << "" << " │ " << padRight("WeightedLRUCache", 16) << " │ "
+             << setprecision(1) << setw(7) << 100.0 * weightedHits / operations << "% │ "
+             << setprecision(2) << setw(12) << operations / weightedTime / 1e6 << " │ "
+             << setw(12) << weighted.size() << " │\n";
+    }
+
+    cout << "└──────────┴──────────────────┴──────────┴──────────────┴──────────────┘\n";
+}
+
+//медленный источник-заглушка: каждая загрузка занимает delay и считается
+class SlowBackend {
+private:
+    atomic<long long> calls;
+    microseconds delay;
+
+public:
+    SlowBackend(microseconds loadDelay) : calls(0), delay(loadDelay) {}
+
+    int load(int key) {
+        calls++;
+        this_thread::sleep_for(delay);
+        return key * 2 + 1;
+    }
+
+    long long callCount() const {
+        return calls;
+    }
+};
+
+//сколько обращений к источнику экономит объединение одновременных промахов
+void benchmarkLoadingCache() {
+    const int threadCounts[] = {4, 16, 64};
+    const int requestsPerThread = 200;
+    //мало горячих ключей: холодный старт - это лавина промахов по одним и тем же ключам
+    const int keySpace = 200;
+    mt19937 gen(31);
+    ZipfGenerator zipf(keySpace, 1.2);
+
+    cout << "\nЗАГРУЗКА ПРИ ПРОМАХЕ: ОБЪЕДИНЕНИЕ ОДНОВРЕМЕННЫХ ПРОМАХОВ (источник 2 мс)\n";
+    cout << "┌─────────┬──────────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    cout << "│ потоки  │ вызовы: get  │ вызовы: once │ объединено   │ время get, с │ время once, с│\n";
+    cout << "├─────────┼──────────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+
+    for (int threads : threadCounts) {
+        vector<vector<int>> keys(threads, vector<int>(requestsPerThread));
+        for (vector<int>& threadKeys : keys) {
+            for (int& key : threadKeys) key = zipf(gen);
+        }
+
+        //без объединения: каждый промах сам идет в источник
+        SlowBackend plainBackend(microseconds(2000));
+        ShardedLRUCache plain(keySpace);
+        vector<thread> workers;
+        auto start = high_resolution_clock::now();
+        for (const vector<int>& threadKeys : keys) {
+            workers.emplace_back([&plain, &plainBackend, &threadKeys]() {
+                for (int key : threadKeys) {
+                    if (plain.get(key) == -1) {
+                        plain.set(key, plainBackend.load(key));
+                    }
+                }
+            });
+        }
+        for (thread& worker : workers) worker.join();
+        double plainTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        SlowBackend onceBackend(microseconds(2000));
+        LoadingCache loading(keySpace);
+        LoadingCache::Loader loader = [&onceBackend](int key) { return onceBackend.load(key); };
+        atomic<int> wrong(0);
+        workers.clear();
+        start = high_resolution_clock::now();
+        for (const vector<int>& threadKeys : keys) {
+            workers.emplace_back([&loading, &loader, &threadKeys, &wrong]() {
+                for (int key : threadKeys) {
+                    if (loading.getOrLoad(key, loader) != key * 2 + 1) wrong++;
+                }
+            });
+        }
+        for (thread& worker : workers) worker.join();
+        double onceTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+        if (wrong > 0) {
+            cout << "Ошибка: getOrLoad вернул неверное значение " << wrong << " раз" << endl;
+        }
+
+        cout << "│ " << setw(7) << threads << " │ "
+             << setw(12) << plainBackend.callCount() << " │ "
+             << setw(12) << onceBackend.callCount() << " │ "
+             << setw(12) << loading.coalescedCount() << " │ "
+             << fixed << setprecision(3) << setw(12) << plainTime << " │ "
+             << setw(12) << onceTime << " │\n";
+    }
+
+    cout << "└─────────┴──────────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n";
+
+    //фоновое обновление: ключи живут 40 мс, обновляются за 15 мс до истечения
+    SlowBackend backend(microseconds(2000));
+    LoadingCache refreshing(100, 40, 15);
+    LoadingCache::Loader loader = [&backend](int key) { return backend.load(key); };
+    long long blocking = 0;
+    auto end = high_resolution_clock::now() + milliseconds(400);
+    while (high_resolution_clock::now() < end) {
+        for (int key = 0; key < 10; key++) {
+            auto requestStart = high_resolution_clock::now();
+            refreshing.getOrLoad(key, loader);
+            if (high_resolution_clock::now() - requestStart >= microseconds(1500)) blocking++;
+        }
+        this_thread::sleep_for(milliseconds(1));
+    }
+    cout << "Фоновое обновление за 400 мс (10 ключей, TTL 40 мс): загрузок " << backend.callCount()
+         << ", из них фоновых " << refreshing.refreshCount() << ", запросов, ждавших источник " << blocking << endl;
+}
+
+//теплый перезапуск: пауза на снимок, фоновая запись и восстановление через mmap
+void benchmarkSnapshot() {
+    const int capacities[] = {1000000, 4000000};
+    const string filename = "lru_snapshot.bin";
+    mt19937 gen(37);
+
+    cout << "\nСНИМОК КЭША ДЛЯ ТЕПЛОГО ПЕРЕЗАПУСКА\n";
+    cout << "┌──────────┬──────────────┬──────────────┬──────────┬──────────────┬──────────────┐\n";
+    cout << "│ записей  │ пауза, с     │ запись, с    │ файл, МБ │ mmap+load, с │ set по одной │\n";
+    cout << "├──────────┼──────────────┼──────────────┼──────────┼──────────────┼──────────────┤\n";
+
+    for (int capacity : capacities) {
+        IndexLRUCache cache(capacity);
+        uniform_int_distribution<int> keys(0, 4 * capacity);
+        while (cache.size() < capacity) {
+            int key = keys(gen);
+            cache.set(key, key / 2);
+        }
+
+        //get/set блокируются только на копирование массива ячеек
+        auto start = high_resolution_clock::now();
+        vector<IndexLRUCache::Image> images;
+        images.push_back(cache.image());
+        double pauseTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        start = high_resolution_clock::now();
+        future<bool> saved = async(launch::async, [&images, &filename, capacity]() {
+            return writeSnapshot(images, filename, capacity);
+        });
+        if (!saved.get()) {
+            return;
+        }
+        double writeTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        start = high_resolution_clock::now();
+        IndexLRUCache restored(capacity);
+        loadSnapshot(restored, filename);
+        double loadTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        //для сравнения: те же пары через set, от самого давнего к самому недавнему
+        vector<pair<int, int>> pairs;
+        pairs.reserve(capacity);
+        const IndexLRUCache::Image& image = images.front();
+        for (int32_t slot = image.head; slot != -1; slot = image.slots[slot].next) {
+            pairs.push_back({image.slots[slot].key, image.slots[slot].value});
+        }
+        start = high_resolution_clock::now();
+        IndexLRUCache replayed(capacity);
+        for (auto it = pairs.rbegin(); it != pairs.rend(); ++it) {
+            replayed.set(it->first, it->second);
+        }
+        double replayTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        int mismatches = 0;
+        for (const auto& entry : pairs) {
+            if (restored.peek(entry.first) != entry.second) mismatches++;
+        }
+        if (mismatches > 0) {
+            cout << "Ошибка: после восстановления не совпало " << mismatches << " ключей" << endl;
+        }
+
+        ifstream file(filename, ios::binary | ios::ate);
+        cout << "│ " << setw(8) << capacity << " │ "
+             << fixed << setprecision(6) << setw(12) << pauseTime << " │ "
+             << setw(12) << writeTime << " │ "
+             << setprecision(1) << setw(8) << file.tellg() / 1048576.0 << " │ "
+             << setprecision(6) << setw(12) << loadTime << " │ "
+             << setw(12) << replayTime << " │\n";
+    }
+    remove(filename.c_str());
+
+    cout << "└──────────┴──────────────┴──────────────┴──────────┴──────────────┴──────────────┘\n";
+}
+
+int main() {
+    benchmarkIndexLru();
+    benchmarkShardedLru();
+    benchmarkClock();
+    benchmarkTinyLfu();
+    benchmarkPolicies();
+    benchmarkTtl();
+    benchmarkWeighted();
+    benchmarkLoadingCache();
+    benchmarkSnapshot();
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,168 @@
+#ifndef LRU_SNAPSHOT_H
+#define LRU_SNAPSHOT_H
+
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <future>
+#include <fcntl.h>
+#include <unistd.h>
+#include "mappedFile.h"
+#include "indexLru.h"
+#include "shardedLru.h"
+
+//снимок LRU-кэша для теплого перезапуска. формат: "LRUS", версия (uint32), число пар (uint64),
+//число сегментов и емкость кэша (uint32), затем пары (int32 ключ, int32 значение).
+//пары каждого сегмента идут от самого недавнего к самому давнему, сегменты - друг за другом:
+//общего порядка между сегментами снимок не хранит.
+//файл пишется во временный, сбрасывается на диск (fsync) и переименовывается, затем
+//сбрасывается каталог - после сбоя остается либо прежний снимок, либо новый целиком
+
+const uint32_t LRU_SNAPSHOT_VERSION = 2;
+
+struct LruSnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint32_t shardCount;
+    uint32_t capacity;
+};
+
+//сброс на диск записи каталога, в котором лежит файл (после rename)
+inline bool syncDirectory(const std::string& filename) {
+    size_t slash = filename.rfind('/');
+    std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : filename.substr(0, slash));
+    int fd = open(directory.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = fsync(fd) == 0;
+    close(fd);
+    return ok;
+}
+
+//запись образов сегментов в файл: порядок восстанавливается по ссылкам prev/next каждого образа.
+//capacity - емкость всего кэша, число сегментов - число образов
+inline bool writeSnapshot(const std::vector<IndexLRUCache::Image>& images, const std::string& filename, int capacity) {
+    std::string temporary = filename + ".tmp";
+    FILE* file = fopen(temporary.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Ошибка открытия файла для записи: " << temporary << std::endl;
+        return false;
+    }
+
+    LruSnapshotHeader header{{'L', 'R', 'U', 'S'}, LRU_SNAPSHOT_VERSION, 0,
+                             static_cast<uint32_t>(images.size()), static_cast<uint32_t>(capacity)};
+    for (const IndexLRUCache::Image& image : images) {
+        header.count += image.slots.size();
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    //пары копятся в буфере и пишутся блоками
+    std::vector<int32_t> buffer;
+    buffer.reserve(1 << 16);
+    for (const IndexLRUCache::Image& image : images) {
+        for (int32_t slot = image.head; slot != -1 && ok; slot = image.slots[slot].next) {
+            buffer.push_back(image.slots[slot].key);
+            buffer.push_back(image.slots[slot].value);
+            if (buffer.size() == buffer.capacity()) {
+                ok = fwrite(buffer.data(), sizeof(int32_t), buffer.size(), file) == buffer.size();
+                buffer.clear();
+            }
+        }
+    }
+    if (ok && !buffer.empty()) {
+        ok = fwrite(buffer.data(), sizeof(int32_t), buffer.size(), file) == buffer.size();
+    }
+
+    //данные должны оказаться на диске раньше, чем переименование
+    ok = ok && fflush(file) == 0 && fsync(fileno(file)) == 0;
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Ошибка записи снимка: " << filename << std::endl;
+        remove(temporary.c_str());
+        return false;
+    }
+    if (!syncDirectory(filename)) {
+        std::cerr << "Ошибка сброса каталога снимка на диск: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//фоновое сохранение: под блокировкой кэш только копирует массив ячеек,
+//обход списка и запись в файл идут в отдельном потоке
+inline std::future<bool> saveSnapshotAsync(const IndexLRUCache& cache, const std::string& filename) {
+    std::vector<IndexLRUCache::Image> images;
+    images.push_back(cache.image());
+    int capacity = cache.maxSize();
+    return std::async(std::launch::async, [images = std::move(images), filename, capacity]() {
+        return writeSnapshot(images, filename, capacity);
+    });
+}
+
+inline std::future<bool> saveSnapshotAsync(ShardedLRUCache& cache, const std::string& filename) {
+    int capacity = cache.maxSize();
+    return std::async(std::launch::async, [images = cache.images(), filename, capacity]() {
+        return writeSnapshot(images, filename, capacity);
+    });
+}
+
+//отображение снимка в память и проверка заголовка; load получает заголовок и массив пар
+//и возвращает false, если снимок не подходит кэшу
+template<typename Load>
+bool mapSnapshot(const std::string& filename, Load load) {
+    MappedFile file(filename);
+    if (!file.valid() || file.size() < sizeof(LruSnapshotHeader)) {
+        std::cerr << "Ошибка открытия снимка: " << filename << std::endl;
+        return false;
+    }
+
+    LruSnapshotHeader header;
+    memcpy(&header, file.data(), sizeof(header));
+    size_t payload = file.size() - sizeof(header);
+    if (memcmp(header.magic, "LRUS", 4) != 0 || header.version != LRU_SNAPSHOT_VERSION ||
+        payload % (2 * sizeof(int32_t)) != 0 || header.count != payload / (2 * sizeof(int32_t))) {
+        std::cerr << "Снимок поврежден: " << filename << std::endl;
+        return false;
+    }
+
+    if (!load(header, reinterpret_cast<const int32_t*>(file.data() + sizeof(header)))) {
+        std::cerr << "Снимок снят с кэша другой конфигурации (сегментов: " << header.shardCount
+             << ", емкость: " << header.capacity << "): " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//восстановление в пустой кэш одним проходом по отображенному файлу.
+//подходит только снимок несегментированного кэша: в нем один общий порядок,
+//и если снимок больше емкости, сохраняются самые недавние ключи
+inline bool loadSnapshot(IndexLRUCache& cache, const std::string& filename) {
+    return mapSnapshot(filename, [&cache](const LruSnapshotHeader& header, const int32_t* pairs) {
+        if (header.shardCount != 1) {
+            return false;
+        }
+        cache.bulkLoad(pairs, header.count);
+        return true;
+    });
+}
+
+//снимок сегментированного кэша хранит порядок только внутри сегментов, поэтому подходит
+//лишь кэшу с тем же числом сегментов и не меньшей емкостью: ключ попадает в сегмент
+//с тем же номером, и ни один сегмент не переполняется
+inline bool loadSnapshot(ShardedLRUCache& cache, const std::string& filename) {
+    return mapSnapshot(filename, [&cache](const LruSnapshotHeader& header, const int32_t* pairs) {
+        if (header.shardCount != static_cast<uint32_t>(cache.shardCount()) ||
+            header.capacity > static_cast<uint32_t>(cache.maxSize())) {
+            return false;
+        }
+        cache.bulkLoad(pairs, header.count);
+        return true;
+    });
+}
+
+#endif
\ No newline at end of file
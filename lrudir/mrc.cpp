@@ -0,0 +1,269 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cmath>
+
+using namespace std;
+
+//дерево Фенвика над моментами обращений: 1 - в этот момент было последнее обращение к ключу
+class FenwickTree {
+private:
+    vector<int> tree;
+
+public:
+    void reset(size_t size) {
+        tree.assign(size + 1, 0);
+    }
+
+    size_t size() const {
+        return tree.size() - 1;
+    }
+
+    void add(size_t position, int delta) {
+        for (size_t i = position + 1; i < tree.size(); i += i & (~i + 1)) {
+            tree[i] += delta;
+        }
+    }
+
+    //сумма на [0, position]
+    long long prefix(size_t position) const {
+        long long sum = 0;
+        for (size_t i = position + 1; i > 0; i -= i & (~i + 1)) {
+            sum += tree[i];
+        }
+        return sum;
+    }
+};
+
+//построение кривой промахов LRU за один проход: для каждого обращения считается
+//стековое расстояние - число разных ключей после предыдущего обращения к тому же ключу.
+//кэш емкости c попадает ровно тогда, когда расстояние меньше c
+class MissRatioCurve {
+private:
+    FenwickTree marks;
+    unordered_map<int, size_t> lastAccess; //ключ -> момент последнего обращения
+    size_t clock;
+    vector<long long> histogram; //число обращений с данным расстоянием
+    long long coldMisses;
+    long long accesses;
+
+    //моменты обращений нумеруются заново по порядку, чтобы дерево не росло с длиной трассы
+    void compact() {
+        vector<pair<size_t, int>> order;
+        order.reserve(lastAccess.size());
+        for (const auto& entry : lastAccess) {
+            order.push_back({entry.second, entry.first});
+        }
+        sort(order.begin(), order.end());
+
+        marks.reset(max<size_t>(1024, 2 * order.size()));
+        for (size_t i = 0; i < order.size(); i++) {
+            lastAccess[order[i].second] = i;
+            marks.add(i, 1);
+        }
+        clock = order.size();
+    }
+
+public:
+    MissRatioCurve() : clock(0), coldMisses(0), accesses(0) {
+        marks.reset(1024);
+    }
+
+    void access(int key) {
+        accesses++;
+        if (clock == marks.size()) {
+            compact();
+        }
+
+        auto it = lastAccess.find(key);
+        if (it == lastAccess.end()) {
+            coldMisses++;
+            lastAccess.emplace(key, clock);
+        } else {
+            size_t previous = it->second;
+            //ключи, к которым обращались после previous, - по одной отметке на ключ
+            long long distance = marks.prefix(clock - 1) - marks.prefix(previous);
+            if (static_cast<size_t>(distance) >= histogram.size()) {
+                histogram.resize(distance + 1, 0);
+            }
+            histogram[distance]++;
+            marks.add(previous, -1);
+            it->second = clock;
+        }
+        marks.add(clock, 1);
+        clock++;
+    }
+
+    long long accessCount() const {
+        return accesses;
+    }
+
+    long long distinctKeys() const {
+        return lastAccess.size();
+    }
+
+    //накопленные попадания: hits[c] - число попаданий кэша емкости c
+    vector<long long> cumulativeHits() const {
+        vector<long long> hits(histogram.size() + 1, 0);
+        for (size_t d = 0; d < histogram.size(); d++) {
+            hits[d + 1] = hits[d] + histogram[d];
+        }
+        return hits;
+    }
+};
+
+//отбор ключей по хэшу (SHARDS): обрабатывается доля rate всех ключей,
+//расстояния по выборке масштабируются делением на rate
+bool sampledKey(int key, uint32_t threshold) {
+    uint32_t h = static_cast<uint32_t>(key) * 0x9E3779B1U;
+    h ^= h >> 16;
+    h *= 0x85EBCA6BU;
+    h ^= h >> 13;
+    return (h & 0xFFFFFF) < threshold;
+}
+
+//чтение ключей из трассы: строки "GET <ключ>", "SET <ключ> <значение>" или просто "<ключ>".
+//файл читается блоками, числа разбираются вручную без промежуточных строк
+template<typename Visit>
+bool readTrace(const string& filename, Visit visit) {
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file) {
+        cerr << "Ошибка открытия файла трассы: " << filename << endl;
+        return false;
+    }
+
+    vector<char> buffer(1 << 20);
+    string carry; //незаконченная строка с конца предыдущего блока
+    size_t bytes;
+    auto parseLine = [&](const char* begin, const char* end) {
+        const char* p = begin;
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        while (p < end && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) p++; //команда
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+
+        bool negative = p < end && *p == '-';
+        if (negative) p++;
+        if (p == end || *p < '0' || *p > '9') return; //пустая или неразборчивая строка
+        long long key = 0;
+        while (p < end && *p >= '0' && *p <= '9') {
+            key = key * 10 + (*p++ - '0');
+        }
+        visit(static_cast<int>(negative ? -key : key));
+    };
+
+    while ((bytes = fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        const char* begin = buffer.data();
+        const char* end = begin + bytes;
+        const char* line = begin;
+        for (const char* p = begin; p < end; p++) {
+            if (*p != '\n') continue;
+            if (!carry.empty()) {
+                carry.append(line, p);
+                parseLine(carry.data(), carry.data() + carry.size());
+                carry.clear();
+            } else {
+                parseLine(line, p);
+            }
+            line = p + 1;
+        }
+        carry.append(line, end);
+    }
+    if (!carry.empty()) {
+        parseLine(carry.data(), carry.data() + carry.size());
+    }
+
+    fclose(file);
+    return true;
+}
+
+void printUsage() {
+    cout << "Использование: mrc <трасса> [--sample <доля 0..1>] [--points <число точек>] [--max <емкость>]\n";
+    cout << "Строит кривую доли попаданий LRU для всех емкостей за один проход по трассе\n";
+    cout << "--sample обрабатывает только часть ключей: точность хорошая для емкостей >> 1 / доля\n";
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    string filename = argv[1];
+    double rate = 1.0;
+    int points = 40;
+    long long maxCapacity = 0;
+    for (int i = 2; i + 1 < argc; i += 2) {
+        string option = argv[i];
+        if (option == "--sample") {
+            rate = stod(argv[i + 1]);
+        } else if (option == "--points") {
+            points = stoi(argv[i + 1]);
+        } else if (option == "--max") {
+            maxCapacity = stoll(argv[i + 1]);
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (rate <= 0 || rate > 1 || points < 1) {
+        printUsage();
+        return 1;
+    }
+
+    MissRatioCurve curve;
+    long long totalAccesses = 0;
+    uint32_t threshold = static_cast<uint32_t>(rate * 0x1000000);
+    bool ok = readTrace(filename, [&](int key) {
+        totalAccesses++;
+        if (rate >= 1 || sampledKey(key, threshold)) {
+            curve.access(key);
+        }
+    });
+    if (!ok) {
+        return 1;
+    }
+    if (curve.accessCount() == 0) {
+        cout << "В трассе нет обращений" << endl;
+        return 0;
+    }
+
+    vector<long long> hits = curve.cumulativeHits();
+    //емкость c на полной трассе соответствует емкости c * rate на выборке
+    long long largest = static_cast<long long>(ceil((hits.size() - 1) / rate));
+    if (maxCapacity <= 0 || maxCapacity > largest) {
+        maxCapacity = max(1LL, largest);
+    }
+
+    //поправка SHARDS-adj: выборка по ключам может захватить больше или меньше обращений,
+    //чем rate от всех, - разница относится к самым коротким расстояниям
+    double expected = totalAccesses * rate;
+    double adjustment = expected - curve.accessCount();
+
+    cout << "Обращений: " << totalAccesses << ", обработано: " << curve.accessCount()
+         << ", разных ключей: " << curve.distinctKeys() << endl;
+    cout << "┌──────────────┬──────────────┐\n";
+    cout << "│ емкость      │ попадания, % │\n";
+    cout << "├──────────────┼──────────────┤\n";
+
+    //точки по логарифмической шкале от 1 до maxCapacity
+    long long previous = 0;
+    for (int i = 1; i <= points; i++) {
+        long long capacity = static_cast<long long>(llround(pow(static_cast<double>(maxCapacity), static_cast<double>(i) / points)));
+        if (capacity <= previous) continue;
+        previous = capacity;
+
+        size_t scaled = min<size_t>(static_cast<size_t>(capacity * rate), hits.size() - 1);
+        double sampledHits = scaled > 0 ? hits[scaled] + adjustment : 0.0;
+        double ratio = 100.0 * min(expected, max(0.0, sampledHits)) / expected;
+        cout << "│ " << setw(12) << capacity << " │ " << fixed << setprecision(3) << setw(12) << ratio << " │\n";
+    }
+
+    cout << "└──────────────┴──────────────┘\n";
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#ifndef SHARDED_LRU_H
+#define SHARDED_LRU_H
+
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+#include <climits>
+#include "indexLru.h"
+
+//потокобезопасный LRU-кэш: ключи распределяются по независимым сегментам,
+//у каждого сегмента своя блокировка и своя доля емкости.
+//в режиме bufferedReads get берет блокировку только на чтение, а обновления
+//порядка копит в буфере сегмента и применяет пачкой под монопольной блокировкой
+class ShardedLRUCache {
+private:
+    static constexpr int READ_BUFFER_SIZE = 64;
+    //пустая ячейка буфера; попадания по ключу INT_MIN в буфер не записываются
+    static constexpr int NO_READ = INT_MIN;
+
+    //выравнивание по кэш-линии: сегменты не мешают друг другу
+    struct alignas(64) Shard {
+        std::shared_mutex lock;
+        IndexLRUCache cache;
+        std::atomic<int> readCount;
+        std::atomic<int> reads[READ_BUFFER_SIZE];
+
+        Shard(int capacity) : cache(capacity), readCount(0) {
+            for (std::atomic<int>& read : reads) {
+                read.store(NO_READ, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    uint32_t shardMask;
+    bool bufferedReads;
+    int totalCapacity;
+
+    //сегмент выбирается по старшим битам хэша, таблица сегмента использует младшие
+    Shard& shardFor(int key) {
+        uint32_t h = static_cast<uint32_t>(key) * 0x85EBCA6BU;
+        h ^= h >> 13;
+        return *shards[(h >> 16) & shardMask];
+    }
+
+    //применение накопленных попаданий; вызывается под монопольной блокировкой.
+    //читатель мог уже занять ячейку, но еще не записать ключ - такие ячейки пусты и пропускаются
+    void drainReads(Shard& shard) {
+        int pending = std::min(shard.readCount.load(std::memory_order_relaxed), READ_BUFFER_SIZE);
+        for (int i = 0; i < pending; i++) {
+            int key = shard.reads[i].exchange(NO_READ, std::memory_order_relaxed);
+            if (key != NO_READ) {
+                shard.cache.touch(key);
+            }
+        }
+        shard.readCount.store(0, std::memory_order_relaxed);
+    }
+
+    //запись попадания в буфер; при переполнении попадание теряется -
+    //порядок становится приближенным, но get никогда не ждет
+    void recordRead(Shard& shard, int key) {
+        if (key == NO_READ) {
+            return;
+        }
+        int index = shard.readCount.fetch_add(1, std::memory_order_relaxed);
+        if (index >= READ_BUFFER_SIZE) {
+            return;
+        }
+        shard.reads[index].store(key, std::memory_order_relaxed);
+        if (index == READ_BUFFER_SIZE - 1) {
+            std::unique_lock<std::shared_mutex> guard(shard.lock);
+            drainReads(shard);
+        }
+    }
+
+public:
+    ShardedLRUCache(int capacity, int shardCount = 16, bool buffered = true) : bufferedReads(buffered) {
+        //число сегментов - степень двойки, не больше емкости: пустых сегментов не бывает
+        capacity = std::max(1, capacity);
+        uint32_t count = 1;
+        while (count < static_cast<uint32_t>(shardCount) && count * 2 <= static_cast<uint32_t>(capacity)) count <<= 1;
+        shardMask = count - 1;
+
+        //емкость делится точно: первые capacity % count сегментов получают на ячейку больше
+        int base = capacity / static_cast<int>(count);
+        int extra = capacity % static_cast<int>(count);
+        for (int i = 0; i < static_cast<int>(count); i++) {
+            shards.push_back(std::make_unique<Shard>(base + (i < extra ? 1 : 0)));
+        }
+        totalCapacity = capacity;
+    }
+
+    int get(int key) {
+        Shard& shard = shardFor(key);
+        if (!bufferedReads) {
+            std::unique_lock<std::shared_mutex> guard(shard.lock);
+            return shard.cache.get(key);
+        }
+
+        int value;
+        {
+            std::shared_lock<std::shared_mutex> guard(shard.lock);
+            value = shard.cache.peek(key);
+        }
+        if (value != -1) {
+            recordRead(shard, key);
+        }
+        return value;
+    }
+
+    void set(int key, int value) {
+        Shard& shard = shardFor(key);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        //перед вытеснением учитываем последние попадания
+        if (bufferedReads && shard.readCount.load(std::memory_order_relaxed) > 0) {
+            drainReads(shard);
+        }
+        shard.cache.set(key, value);
+    }
+
+    //снимки сегментов; каждый сегмент блокируется только на время копирования своих ячеек
+    std::vector<IndexLRUCache::Image> images() {
+        std::vector<IndexLRUCache::Image> result;
+        for (auto& shard : shards) {
+            std::unique_lock<std::shared_mutex> guard(shard->lock);
+            if (bufferedReads) {
+                drainReads(*shard);
+            }
+            result.push_back(shard->cache.image());
+        }
+        return result;
+    }
+
+    //загрузка пар (ключ, значение) от самого недавнего; все сегменты блокируются на время загрузки
+    void bulkLoad(const int32_t* pairs, size_t pairCount) {
+        std::vector<std::unique_lock<std::shared_mutex>> guards;
+        for (auto& shard : shards) {
+            guards.emplace_back(shard->lock);
+        }
+        for (size_t i = 0; i < pairCount; i++) {
+            shardFor(pairs[2 * i]).cache.appendOldest(pairs[2 * i], pairs[2 * i + 1]);
+        }
+    }
+
+    int shardCount() const {
+        return static_cast<int>(shards.size());
+    }
+
+    int maxSize() const {
+        return totalCapacity;
+    }
+
+    int size() {
+        int total = 0;
+        for (auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard(shard->lock);
+            total += shard->cache.size();
+        }
+        return total;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef SLOT_LISTS_H
+#define SLOT_LISTS_H
+
+#include <vector>
+#include <cstdint>
+#include "slotTable.h"
+
+//пул узлов на индексах и несколько двусвязных списков над ним.
+//узлы выделяются из стека свободных, поэтому после конструктора память не выделяется.
+//голова списка - самый недавно добавленный узел, хвост - самый старый
+class SlotLists {
+public:
+    static constexpr int32_t NONE = SlotTable::NONE;
+
+    struct Node {
+        int key;
+        int value;
+        int32_t prev;
+        int32_t next;
+        uint8_t list; //номер списка, в котором лежит узел
+    };
+
+private:
+    struct List {
+        int32_t head;
+        int32_t tail;
+        int size;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<int32_t> freeNodes;
+    std::vector<List> lists;
+
+public:
+    SlotLists(int nodeCount, int listCount) : nodes(nodeCount), lists(listCount, List{NONE, NONE, 0}) {
+        freeNodes.reserve(nodeCount);
+        for (int32_t i = nodeCount - 1; i >= 0; i--) {
+            freeNodes.push_back(i);
+        }
+    }
+
+    Node& operator[](int32_t node) {
+        return nodes[node];
+    }
+
+    const Node& operator[](int32_t node) const {
+        return nodes[node];
+    }
+
+    int32_t allocate(int key, int value) {
+        int32_t node = freeNodes.back();
+        freeNodes.pop_back();
+        nodes[node].key = key;
+        nodes[node].value = value;
+        return node;
+    }
+
+    void release(int32_t node) {
+        freeNodes.push_back(node);
+    }
+
+    void pushFront(int32_t node, int list) {
+        List& target = lists[list];
+        nodes[node].list = list;
+        nodes[node].prev = NONE;
+        nodes[node].next = target.head;
+        if (target.head != NONE) nodes[target.head].prev = node;
+        target.head = node;
+        if (target.tail == NONE) target.tail = node;
+        target.size++;
+    }
+
+    void unlink(int32_t node) {
+        Node& n = nodes[node];
+        List& source = lists[n.list];
+        if (n.prev != NONE) nodes[n.prev].next = n.next; else source.head = n.next;
+        if (n.next != NONE) nodes[n.next].prev = n.prev; else source.tail = n.prev;
+        source.size--;
+    }
+
+    void moveToFront(int32_t node, int list) {
+        unlink(node);
+        pushFront(node, list);
+    }
+
+    int32_t back(int list) const {
+        return lists[list].tail;
+    }
+
+    int size(int list) const {
+        return lists[list].size;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef SLOT_TABLE_H
+#define SLOT_TABLE_H
+
+#include <vector>
+#include <cstdint>
+
+//таблица ключ -> номер ячейки с открытой адресацией (линейное пробирование).
+//размер фиксируется в конструкторе, поэтому операции не выделяют память
+class SlotTable {
+public:
+    static constexpr int32_t NONE = -1;
+
+private:
+    struct Entry {
+        int key;
+        int32_t slot; //NONE - позиция свободна
+    };
+
+    std::vector<Entry> entries;
+    uint32_t mask;
+
+    uint32_t hashKey(int key) const {
+        uint32_t h = static_cast<uint32_t>(key) * 0x9E3779B1U;
+        return (h ^ (h >> 16)) & mask;
+    }
+
+    //позиция ключа либо свободная позиция, куда его можно вставить
+    uint32_t findPosition(int key) const {
+        uint32_t pos = hashKey(key);
+        while (entries[pos].slot != NONE && entries[pos].key != key) {
+            pos = (pos + 1) & mask;
+        }
+        return pos;
+    }
+
+public:
+    SlotTable(int capacity) {
+        //таблица заполнена не более чем наполовину
+        uint32_t tableSize = 1;
+        while (tableSize < 2U * static_cast<uint32_t>(capacity > 0 ? capacity : 1)) tableSize <<= 1;
+        entries.assign(tableSize, Entry{0, NONE});
+        mask = tableSize - 1;
+    }
+
+    int32_t find(int key) const {
+        return entries[findPosition(key)].slot;
+    }
+
+    //вставка или замена ячейки ключа
+    void insert(int key, int32_t slot) {
+        Entry& entry = entries[findPosition(key)];
+        entry.key = key;
+        entry.slot = slot;
+    }
+
+    //вставка, только если ключа еще нет (один проход по цепочке)
+    bool tryInsert(int key, int32_t slot) {
+        Entry& entry = entries[findPosition(key)];
+        if (entry.slot != NONE) {
+            return false;
+        }
+        entry.key = key;
+        entry.slot = slot;
+        return true;
+    }
+
+    //подсказка процессору заранее загрузить позицию ключа (для пакетной загрузки)
+    void prefetch(int key) const {
+        __builtin_prefetch(&entries[hashKey(key)]);
+    }
+
+    //удаление без "надгробий": следующие элементы цепочки сдвигаются назад
+    void erase(int key) {
+        uint32_t pos = findPosition(key);
+        if (entries[pos].slot == NONE) {
+            return;
+        }
+
+        uint32_t next = (pos + 1) & mask;
+        while (entries[next].slot != NONE) {
+            uint32_t home = hashKey(entries[next].key);
+            //элемент можно перенести в pos, если pos лежит между home и next по кругу
+            if (((next - home) & mask) >= ((next - pos) & mask)) {
+                entries[pos] = entries[next];
+                pos = next;
+            }
+            next = (next + 1) & mask;
+        }
+        entries[pos].slot = NONE;
+    }
+};
+
+#endif
\ No newline at end of file
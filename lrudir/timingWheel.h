@@ -0,0 +1,136 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <vector>
+#include <cstdint>
+
+//иерархическое колесо таймеров: 4 уровня по 256 корзин, уровень l хранит таймеры,
+//до срабатывания которых от 256^l до 256^(l+1) тиков. таймеры - ячейки внешнего
+//массива (номера 0..slotCount-1), корзины - двусвязные списки на индексах.
+//постановка и отмена - O(1), каждый тик - O(1) плюс работа со сработавшими таймерами;
+//таймер переносится на уровень ниже не более 3 раз за всю жизнь
+class TimingWheel {
+public:
+    static constexpr int32_t NONE = -1;
+
+private:
+    static constexpr int LEVELS = 4;
+    static constexpr int BITS = 8;
+    static constexpr int BUCKETS = 1 << BITS;
+
+    struct Timer {
+        uint64_t expiresAt;
+        int32_t prev;
+        int32_t next;
+        int32_t bucket; //номер корзины во всех уровнях, NONE - таймер не запущен
+    };
+
+    std::vector<Timer> timers;
+    std::vector<int32_t> buckets; //голова списка каждой корзины
+    uint64_t currentTick;
+    int active;
+
+    void link(int32_t slot, int32_t bucket) {
+        Timer& timer = timers[slot];
+        timer.bucket = bucket;
+        timer.prev = NONE;
+        timer.next = buckets[bucket];
+        if (buckets[bucket] != NONE) timers[buckets[bucket]].prev = slot;
+        buckets[bucket] = slot;
+    }
+
+    void unlink(int32_t slot) {
+        Timer& timer = timers[slot];
+        if (timer.prev != NONE) timers[timer.prev].next = timer.next; else buckets[timer.bucket] = timer.next;
+        if (timer.next != NONE) timers[timer.next].prev = timer.prev;
+        timer.bucket = NONE;
+    }
+
+    //корзина по времени до срабатывания: чем дальше срок, тем грубее уровень
+    void place(int32_t slot) {
+        uint64_t expiresAt = timers[slot].expiresAt;
+        uint64_t delta = expiresAt - currentTick;
+        int level = 0;
+        while (level < LEVELS - 1 && delta >= (1ULL << (BITS * (level + 1)))) {
+            level++;
+        }
+        link(slot, level * BUCKETS + ((expiresAt >> (BITS * level)) & (BUCKETS - 1)));
+    }
+
+    //перенос таймеров корзины уровня level на уровни ниже
+    void cascade(int level) {
+        int32_t bucket = level * BUCKETS + ((currentTick >> (BITS * level)) & (BUCKETS - 1));
+        int32_t slot = buckets[bucket];
+        buckets[bucket] = NONE;
+        while (slot != NONE) {
+            int32_t next = timers[slot].next;
+            place(slot);
+            slot = next;
+        }
+    }
+
+public:
+    TimingWheel(int slotCount) : timers(slotCount, Timer{0, NONE, NONE, NONE}),
+                                 buckets(LEVELS * BUCKETS, NONE), currentTick(0), active(0) {}
+
+    uint64_t now() const {
+        return currentTick;
+    }
+
+    bool scheduled(int32_t slot) const {
+        return timers[slot].bucket != NONE;
+    }
+
+    //тик срабатывания запущенного таймера
+    uint64_t expiresAt(int32_t slot) const {
+        return timers[slot].expiresAt;
+    }
+
+    //запуск (или перезапуск) таймера через ticks тиков (не меньше одного)
+    void schedule(int32_t slot, uint64_t ticks) {
+        cancel(slot);
+        if (ticks == 0) ticks = 1;
+        //самый дальний срок, при котором корзина старшего уровня не совпадает с текущей
+        uint64_t maxTicks = (1ULL << (BITS * LEVELS)) - (1ULL << (BITS * (LEVELS - 1)));
+        if (ticks > maxTicks) ticks = maxTicks;
+        timers[slot].expiresAt = currentTick + ticks;
+        place(slot);
+        active++;
+    }
+
+    void cancel(int32_t slot) {
+        if (timers[slot].bucket != NONE) {
+            unlink(slot);
+            active--;
+        }
+    }
+
+    //продвижение времени до tick; onExpire(slot) вызывается для каждого сработавшего таймера
+    template<typename OnExpire>
+    void advance(uint64_t tick, OnExpire onExpire) {
+        while (currentTick < tick) {
+            if (active == 0) {
+                //пустое колесо: тики можно пропустить целиком
+                currentTick = tick;
+                return;
+            }
+            currentTick++;
+
+            //когда младший уровень проходит полный круг, спускаем корзину уровня выше
+            for (int level = 1; level < LEVELS; level++) {
+                if (((currentTick >> (BITS * (level - 1))) & (BUCKETS - 1)) != 0) break;
+                cascade(level);
+            }
+
+            int32_t bucket = currentTick & (BUCKETS - 1);
+            while (buckets[bucket] != NONE) {
+                int32_t slot = buckets[bucket];
+                unlink(slot);
+                active--;
+                onExpire(slot);
+            }
+        }
+    }
+};
+
+#endif
\ No newline at end of file
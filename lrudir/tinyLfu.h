@@ -0,0 +1,260 @@
+#ifndef TINY_LFU_H
+#define TINY_LFU_H
+
+#include <vector>
+#include <cstdint>
+#include "slotTable.h"
+
+//приближенный счетчик частот (count-min): 4 строки по width 4-битных счетчиков,
+//16 счетчиков в одном uint64_t. после sampleSize увеличений все счетчики делятся
+//пополам, поэтому старая популярность постепенно забывается
+class FrequencySketch {
+private:
+    std::vector<uint64_t> table;
+    uint32_t rowMask; //width - 1, width - степень двойки
+    int additions;
+    int sampleSize;
+
+    static uint32_t hashKey(int key, int row) {
+        static const uint32_t seeds[4] = {0x9E3779B1U, 0x85EBCA77U, 0xC2B2AE3DU, 0x27D4EB2FU};
+        uint32_t h = (static_cast<uint32_t>(key) + row) * seeds[row];
+        h ^= h >> 15;
+        h *= 0x2C1B3C6DU;
+        return h ^ (h >> 12);
+    }
+
+    //номер счетчика строки row в общем массиве счетчиков
+    uint32_t counterIndex(int key, int row) const {
+        return row * (rowMask + 1) + (hashKey(key, row) & rowMask);
+    }
+
+    int counter(uint32_t index) const {
+        return (table[index >> 4] >> ((index & 15) * 4)) & 15;
+    }
+
+    //старение: все счетчики делятся пополам одним сдвигом слова
+    void halve() {
+        for (uint64_t& word : table) {
+            word = (word >> 1) & 0x7777777777777777ULL;
+        }
+        additions /= 2;
+    }
+
+public:
+    FrequencySketch(int capacity) : additions(0) {
+        uint32_t width = 16;
+        while (width < static_cast<uint32_t>(capacity)) width <<= 1;
+        rowMask = width - 1;
+        table.assign(4 * width / 16, 0);
+        sampleSize = 10 * (capacity > 0 ? capacity : 1);
+    }
+
+    void increment(int key) {
+        bool added = false;
+        for (int row = 0; row < 4; row++) {
+            uint32_t index = counterIndex(key, row);
+            if (counter(index) < 15) {
+                table[index >> 4] += 1ULL << ((index & 15) * 4);
+                added = true;
+            }
+        }
+        if (added && ++additions >= sampleSize) {
+            halve();
+        }
+    }
+
+    int frequency(int key) const {
+        int result = 15;
+        for (int row = 0; row < 4; row++) {
+            int value = counter(counterIndex(key, row));
+            if (value < result) result = value;
+        }
+        return result;
+    }
+};
+
+//кэш W-TinyLFU: новые ключи попадают в маленькое окно LRU (1% емкости),
+//основная часть - сегментированный LRU (испытательный сегмент и защищенный, 80%).
+//вытесненный из окна кандидат попадает в основную часть, только если по оценке
+//FrequencySketch он встречался чаще, чем жертва из хвоста испытательного сегмента.
+//поэтому сканы однократных ключей не вымывают горячие ключи
+class TinyLFUCache {
+private:
+    static constexpr int32_t NONE = SlotTable::NONE;
+
+    enum Segment : uint8_t {
+        WINDOW = 0,
+        PROBATION = 1,
+        PROTECTED = 2
+    };
+
+    struct Slot {
+        int key;
+        int value;
+        int32_t prev;
+        int32_t next;
+        Segment segment;
+    };
+
+    //список на индексах: голова - самый недавно использованный
+    struct List {
+        int32_t head;
+        int32_t tail;
+        int size;
+    };
+
+    int capacity;
+    int maxWindow;
+    int maxMain;
+    int maxProtected;
+    int count;
+    std::vector<Slot> slots;
+    std::vector<int32_t> freeSlots;
+    SlotTable table;
+    FrequencySketch sketch;
+    List lists[3];
+    int lastMissKey;    //ключ последнего промаха get: его set уже учтен в частоте
+    bool hasLastMiss;
+
+    void unlink(int32_t slot) {
+        Slot& s = slots[slot];
+        List& list = lists[s.segment];
+        if (s.prev != NONE) slots[s.prev].next = s.next; else list.head = s.next;
+        if (s.next != NONE) slots[s.next].prev = s.prev; else list.tail = s.prev;
+        list.size--;
+    }
+
+    void pushFront(int32_t slot, Segment segment) {
+        List& list = lists[segment];
+        slots[slot].segment = segment;
+        slots[slot].prev = NONE;
+        slots[slot].next = list.head;
+        if (list.head != NONE) slots[list.head].prev = slot;
+        list.head = slot;
+        if (list.tail == NONE) list.tail = slot;
+        list.size++;
+    }
+
+    void moveTo(int32_t slot, Segment segment) {
+        unlink(slot);
+        pushFront(slot, segment);
+    }
+
+    void evict(int32_t slot) {
+        unlink(slot);
+        table.erase(slots[slot].key);
+        freeSlots.push_back(slot);
+        count--;
+    }
+
+    //обращение к ключу в кэше: продвижение между сегментами
+    void onHit(int32_t slot) {
+        if (slots[slot].segment == PROTECTED || slots[slot].segment == WINDOW) {
+            moveTo(slot, slots[slot].segment);
+            return;
+        }
+
+        moveTo(slot, PROTECTED);
+        //переполненный защищенный сегмент возвращает свой хвост на испытание
+        if (lists[PROTECTED].size > maxProtected) {
+            moveTo(lists[PROTECTED].tail, PROBATION);
+        }
+    }
+
+    //кандидат из окна соревнуется с жертвой из основной части
+    void admitFromWindow() {
+        int32_t candidate = lists[WINDOW].tail;
+        if (lists[PROBATION].size + lists[PROTECTED].size < maxMain) {
+            moveTo(candidate, PROBATION);
+            return;
+        }
+
+        int32_t victim = lists[PROBATION].tail != NONE ? lists[PROBATION].tail : lists[PROTECTED].tail;
+        if (victim == NONE) {
+            evict(candidate);
+            return;
+        }
+
+        if (sketch.frequency(slots[candidate].key) > sketch.frequency(slots[victim].key)) {
+            evict(victim);
+            moveTo(candidate, PROBATION);
+        } else {
+            evict(candidate);
+        }
+    }
+
+public:
+    TinyLFUCache(int cap)
+        : capacity(cap > 0 ? cap : 1), count(0), table(capacity + 1), sketch(capacity), lastMissKey(0), hasLastMiss(false) {
+        maxWindow = capacity / 100 > 0 ? capacity / 100 : 1;
+        maxMain = capacity - maxWindow;
+        maxProtected = maxMain * 8 / 10;
+
+        //одна лишняя ячейка: новый ключ вставляется до выбора, кого вытеснить
+        slots.resize(capacity + 1);
+        freeSlots.reserve(capacity + 1);
+        for (int32_t i = capacity; i >= 0; i--) {
+            freeSlots.push_back(i);
+        }
+        for (List& list : lists) {
+            list = List{NONE, NONE, 0};
+        }
+    }
+
+    //частота учитывается и по чтениям, и по записям, иначе при одних записях у кандидата
+    //и жертвы она нулевая и новые ключи не проходят в основную часть. set сразу после
+    //промаха get по тому же ключу (схема "get, при промахе set") второй раз не считается
+    int get(int key) {
+        sketch.increment(key);
+        int32_t slot = table.find(key);
+        if (slot == NONE) {
+            lastMissKey = key;
+            hasLastMiss = true;
+            return -1;
+        }
+        hasLastMiss = false;
+        onHit(slot);
+        return slots[slot].value;
+    }
+
+    void set(int key, int value) {
+        if (!hasLastMiss || lastMissKey != key) {
+            sketch.increment(key);
+        }
+        hasLastMiss = false;
+
+        int32_t slot = table.find(key);
+        if (slot != NONE) {
+            slots[slot].value = value;
+            onHit(slot);
+            return;
+        }
+
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        slots[slot].key = key;
+        slots[slot].value = value;
+        table.insert(key, slot);
+        pushFront(slot, WINDOW);
+        count++;
+
+        if (lists[WINDOW].size > maxWindow) {
+            admitFromWindow();
+        }
+    }
+
+    bool erase(int key) {
+        int32_t slot = table.find(key);
+        if (slot == NONE) {
+            return false;
+        }
+        evict(slot);
+        return true;
+    }
+
+    int size() const {
+        return count;
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,329 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include "mappedFile.h"
+#include "cachePolicies.h"
+#include "workload.h"
+
+using namespace std;
+using namespace std::chrono;
+
+//запрос трассы; в двоичном файле записи лежат подряд после заголовка
+struct TraceRecord {
+    uint32_t op; //0 - GET, 1 - SET
+    int32_t key;
+    int32_t value;
+};
+
+const uint32_t TRACE_GET = 0;
+const uint32_t TRACE_SET = 1;
+
+//заголовок двоичной трассы: "LRUT" и число записей
+struct TraceHeader {
+    char magic[4];
+    uint32_t reserved;
+    uint64_t count;
+};
+
+//трасса в памяти: либо записи прямо в отображенном файле, либо разобранный текст
+struct Trace {
+    unique_ptr<MappedFile> file;
+    vector<TraceRecord> parsed;
+    const TraceRecord* records;
+    size_t count;
+};
+
+//разбор целого числа без промежуточных строк
+bool parseInt(const char*& p, const char* end, int32_t& value) {
+    while (p < end && (*p == ' ' || *p == '\t')) p++;
+    bool negative = p < end && *p == '-';
+    if (negative) p++;
+    if (p == end || *p < '0' || *p > '9') return false;
+    long long result = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        result = result * 10 + (*p++ - '0');
+    }
+    value = static_cast<int32_t>(negative ? -result : result);
+    return true;
+}
+
+//текстовая трасса "GET <ключ>" / "SET <ключ> <значение>" / "<ключ>" прямо из отображенного файла.
+//память под записи выделяется один раз по числу строк
+void parseTextTrace(const char* data, size_t length, vector<TraceRecord>& records) {
+    const char* end = data + length;
+    size_t lines = 1;
+    for (const char* p = data; p < end; p++) {
+        if (*p == '\n') lines++;
+    }
+    records.reserve(lines);
+
+    const char* p = data;
+    while (p < end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', end - p));
+        if (lineEnd == nullptr) lineEnd = end;
+
+        while (p < lineEnd && (*p == ' ' || *p == '\t')) p++;
+        TraceRecord record{TRACE_GET, 0, 0};
+        if (lineEnd - p >= 3 && memcmp(p, "SET", 3) == 0) {
+            record.op = TRACE_SET;
+            p += 3;
+        } else if (lineEnd - p >= 3 && memcmp(p, "GET", 3) == 0) {
+            p += 3;
+        }
+        if (parseInt(p, lineEnd, record.key) &&
+            (record.op == TRACE_GET || parseInt(p, lineEnd, record.value))) {
+            records.push_back(record);
+        }
+        p = lineEnd + 1;
+    }
+}
+
+//загрузка трассы: двоичная используется без копирования, текстовая разбирается
+bool loadTrace(const string& filename, Trace& trace) {
+    trace.file.reset(new MappedFile(filename));
+    if (!trace.file->valid()) {
+        cerr << "Ошибка открытия файла трассы: " << filename << endl;
+        return false;
+    }
+
+    const char* data = trace.file->data();
+    size_t length = trace.file->size();
+    if (length >= sizeof(TraceHeader) && memcmp(data, "LRUT", 4) == 0) {
+        TraceHeader header;
+        memcpy(&header, data, sizeof(header));
+        if ((length - sizeof(header)) / sizeof(TraceRecord) != header.count) {
+            cerr << "Двоичная трасса повреждена: " << filename << endl;
+            return false;
+        }
+        trace.records = reinterpret_cast<const TraceRecord*>(data + sizeof(header));
+        trace.count = header.count;
+        return true;
+    }
+
+    parseTextTrace(data, length, trace.parsed);
+    trace.records = trace.parsed.data();
+    trace.count = trace.parsed.size();
+    return true;
+}
+
+bool saveTrace(const string& filename, const vector<TraceRecord>& records) {
+    ofstream file(filename, ios::binary);
+    if (!file) {
+        cerr << "Ошибка открытия файла для записи: " << filename << endl;
+        return false;
+    }
+    TraceHeader header{{'L', 'R', 'U', 'T'}, 0, records.size()};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(TraceRecord));
+    return static_cast<bool>(file);
+}
+
+//гистограмма задержек: 64 диапазона степеней двойки наносекунд по 16 поддиапазонов,
+//погрешность перцентиля - не больше 1/16 значения
+class LatencyHistogram {
+private:
+    static const int SUB_BUCKETS = 16;
+    vector<long long> counts;
+    long long total;
+
+    static int bucketOf(uint64_t nanos) {
+        if (nanos < SUB_BUCKETS) return static_cast<int>(nanos);
+        int power = 63 - __builtin_clzll(nanos);
+        int sub = static_cast<int>((nanos >> (power - 4)) & (SUB_BUCKETS - 1));
+        return (power - 3) * SUB_BUCKETS + sub;
+    }
+
+    //верхняя граница корзины
+    static uint64_t bucketLimit(int bucket) {
+        if (bucket < SUB_BUCKETS) return bucket;
+        int power = bucket / SUB_BUCKETS + 3;
+        uint64_t sub = bucket % SUB_BUCKETS;
+        return ((SUB_BUCKETS + sub + 1) << (power - 4)) - 1;
+    }
+
+public:
+    LatencyHistogram() : counts(64 * SUB_BUCKETS, 0), total(0) {}
+
+    void record(uint64_t nanos) {
+        counts[bucketOf(nanos)]++;
+        total++;
+    }
+
+    uint64_t percentile(double fraction) const {
+        long long rank = static_cast<long long>(fraction * total);
+        long long seen = 0;
+        for (size_t bucket = 0; bucket < counts.size(); bucket++) {
+            seen += counts[bucket];
+            if (seen > rank) return bucketLimit(bucket);
+        }
+        return 0;
+    }
+};
+
+//один запрос трассы; при fillOnMiss промах GET загружает ключ
+inline bool replayRecord(CachePolicy& cache, const TraceRecord& record, bool fillOnMiss) {
+    if (record.op == TRACE_SET) {
+        cache.set(record.key, record.value);
+        return false;
+    }
+    if (cache.get(record.key) != -1) {
+        return true;
+    }
+    if (fillOnMiss) {
+        cache.set(record.key, record.key);
+    }
+    return false;
+}
+
+//проигрывание трассы для каждой политики: проход без замеров отдельных запросов для
+//пропускной способности и проход со временем каждого запроса для перцентилей
+void replay(const Trace& trace, int capacity, const vector<string>& policies, bool fillOnMiss) {
+    cout << "Запросов: " << trace.count << ", емкость: " << capacity
+         << (fillOnMiss ? ", промах GET загружает ключ" : "") << endl;
+    cout << "┌────────────┬──────────┬──────────────┬──────────┬──────────┬──────────┐\n";
+    cout << "│ политика   │ попадания│ Mops/s       │ p50, нс  │ p99, нс  │ p99.9, нс│\n";
+    cout << "├────────────┼──────────┼──────────────┼──────────┼──────────┼──────────┤\n";
+
+    for (const string& policyName : policies) {
+        unique_ptr<CachePolicy> cache = createCachePolicy(policyName, capacity);
+        auto start = steady_clock::now();
+        for (size_t i = 0; i < trace.count; i++) {
+            replayRecord(*cache, trace.records[i], fillOnMiss);
+        }
+        double seconds = duration_cast<nanoseconds>(steady_clock::now() - start).count() / 1e9;
+        double hitRatio = cache->stats().hitRatio();
+
+        unique_ptr<CachePolicy> timed = createCachePolicy(policyName, capacity);
+        LatencyHistogram histogram;
+        for (size_t i = 0; i < trace.count; i++) {
+            auto requestStart = steady_clock::now();
+            replayRecord(*timed, trace.records[i], fillOnMiss);
+            histogram.record(duration_cast<nanoseconds>(steady_clock::now() - requestStart).count());
+        }
+
+        string name = cache->name();
+        name.resize(10, ' ');
+        cout << "│ " << name << " │ "
+             << fixed << setprecision(1) << setw(7) << 100.0 * hitRatio << "% │ "
+             << setprecision(2) << setw(12) << (seconds > 0 ? trace.count / seconds / 1e6 : 0.0) << " │ "
+             << setw(8) << histogram.percentile(0.5) << " │ "
+             << setw(8) << histogram.percentile(0.99) << " │ "
+             << setw(8) << histogram.percentile(0.999) << " │\n";
+    }
+
+    cout << "└────────────┴──────────┴──────────────┴──────────┴──────────┴──────────┘\n";
+}
+
+//синтетическая трасса из одних GET (проигрывается с загрузкой при промахе)
+vector<TraceRecord> generateTrace(const string& kind, int operations, int keySpace, double alpha, mt19937& gen) {
+    vector<int> keys;
+    if (kind == "uniform") {
+        keys = uniformTrace(operations, keySpace, gen);
+    } else if (kind == "zipf") {
+        keys = scanMixedTrace(operations, keySpace, alpha, 0, 1, gen);
+    } else if (kind == "scan") {
+        //горячие ключи по Ципфу и каждые 10 размеров пространства ключей - скан такой же длины
+        keys = scanMixedTrace(operations, keySpace, alpha, keySpace, 10 * keySpace, gen);
+    } else {
+        throw runtime_error("Неизвестный вид нагрузки: " + kind);
+    }
+
+    vector<TraceRecord> records(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        records[i] = TraceRecord{TRACE_GET, keys[i], 0};
+    }
+    return records;
+}
+
+//разбор списка политик через запятую
+vector<string> splitPolicies(const string& list) {
+    vector<string> result;
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',', start);
+        if (comma == string::npos) comma = list.size();
+        if (comma > start) result.push_back(list.substr(start, comma - start));
+        start = comma + 1;
+    }
+    return result;
+}
+
+void printUsage() {
+    cout << "Использование:\n";
+    cout << "  traceReplay <трасса> [--capacity N] [--policies list,lru,...] [--fill]\n";
+    cout << "  traceReplay --generate uniform|zipf|scan [--ops N] [--keys N] [--alpha A]\n";
+    cout << "              [--capacity N] [--policies ...] [--out файл]\n";
+    cout << "Трасса - текст (GET <ключ> / SET <ключ> <значение>) или двоичный файл, записанный --out.\n";
+    cout << "Политики: list (LRUCache), lru, tinylfu, arc, 2q. --fill: промах GET загружает ключ\n";
+}
+
+int main(int argc, char* argv[]) {
+    string traceFile, generate, outFile;
+    string policyList = "list,lru,tinylfu,arc,2q";
+    int capacity = 10000, operations = 5000000, keySpace = 100000;
+    double alpha = 0.99;
+    bool fillOnMiss = false;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "--fill") {
+                fillOnMiss = true;
+            } else if (arg == "--generate" && hasValue) {
+                generate = argv[++i];
+            } else if (arg == "--out" && hasValue) {
+                outFile = argv[++i];
+            } else if (arg == "--policies" && hasValue) {
+                policyList = argv[++i];
+            } else if (arg == "--capacity" && hasValue) {
+                capacity = stoi(argv[++i]);
+            } else if (arg == "--ops" && hasValue) {
+                operations = stoi(argv[++i]);
+            } else if (arg == "--keys" && hasValue) {
+                keySpace = stoi(argv[++i]);
+            } else if (arg == "--alpha" && hasValue) {
+                alpha = stod(argv[++i]);
+            } else if (arg[0] != '-' && traceFile.empty()) {
+                traceFile = arg;
+            } else {
+                printUsage();
+                return 1;
+            }
+        }
+        if (traceFile.empty() == generate.empty() || capacity < 1 || operations < 1 || keySpace < 1) {
+            printUsage();
+            return 1;
+        }
+
+        Trace trace;
+        if (!generate.empty()) {
+            mt19937 gen(42);
+            trace.parsed = generateTrace(generate, operations, keySpace, alpha, gen);
+            trace.records = trace.parsed.data();
+            trace.count = trace.parsed.size();
+            if (!outFile.empty()) {
+                return saveTrace(outFile, trace.parsed) ? 0 : 1;
+            }
+            //в синтетической трассе нет SET: ключи загружаются при промахе
+            fillOnMiss = true;
+        } else if (!loadTrace(traceFile, trace)) {
+            return 1;
+        }
+
+        replay(trace, capacity, splitPolicies(policyList), fillOnMiss);
+    } catch (const exception& e) {
+        cerr << "Ошибка: " << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
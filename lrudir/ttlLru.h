@@ -0,0 +1,151 @@
+#ifndef TTL_LRU_H
+#define TTL_LRU_H
+
+#include <vector>
+#include <cstdint>
+#include "slotTable.h"
+#include "timingWheel.h"
+
+//LRU-кэш со сроком жизни ключей. время измеряется в тиках, которые задает
+//вызывающий код через advance (например, миллисекунды монотонных часов).
+//сроки хранит TimingWheel: истекшие ключи удаляются на своем тике, не дожидаясь
+//вытеснения или get, и удаление не меняет порядок использования остальных ключей
+class TimedLRUCache {
+private:
+    static constexpr int32_t NONE = SlotTable::NONE;
+
+    struct Slot {
+        int key;
+        int value;
+        int32_t prev;
+        int32_t next;
+    };
+
+    int capacity;
+    int count;
+    int32_t head;
+    int32_t tail;
+    std::vector<Slot> slots;
+    std::vector<int32_t> freeSlots;
+    SlotTable table;
+    TimingWheel wheel;
+    long long expired;
+
+    void unlink(int32_t slot) {
+        Slot& s = slots[slot];
+        if (s.prev != NONE) slots[s.prev].next = s.next; else head = s.next;
+        if (s.next != NONE) slots[s.next].prev = s.prev; else tail = s.prev;
+    }
+
+    void pushFront(int32_t slot) {
+        slots[slot].prev = NONE;
+        slots[slot].next = head;
+        if (head != NONE) slots[head].prev = slot;
+        head = slot;
+        if (tail == NONE) tail = slot;
+    }
+
+    void removeSlot(int32_t slot) {
+        wheel.cancel(slot);
+        unlink(slot);
+        table.erase(slots[slot].key);
+        freeSlots.push_back(slot);
+        count--;
+    }
+
+public:
+    TimedLRUCache(int cap)
+        : capacity(cap > 0 ? cap : 1), count(0), head(NONE), tail(NONE),
+          slots(capacity), table(capacity), wheel(capacity), expired(0) {
+        freeSlots.reserve(capacity);
+        for (int32_t i = capacity - 1; i >= 0; i--) {
+            freeSlots.push_back(i);
+        }
+    }
+
+    int get(int key) {
+        int32_t slot = table.find(key);
+        if (slot == NONE) {
+            return -1;
+        }
+        if (slot != head) {
+            unlink(slot);
+            pushFront(slot);
+        }
+        return slots[slot].value;
+    }
+
+    //ключ без срока жизни
+    void set(int key, int value) {
+        set(key, value, 0);
+    }
+
+    //ttl - срок жизни в тиках, 0 - бессрочно
+    void set(int key, int value, uint64_t ttl) {
+        int32_t slot = table.find(key);
+        if (slot != NONE) {
+            unlink(slot);
+        } else {
+            if (count == capacity) {
+                removeSlot(tail);
+            }
+            slot = freeSlots.back();
+            freeSlots.pop_back();
+            slots[slot].key = key;
+            table.insert(key, slot);
+            count++;
+        }
+
+        slots[slot].value = value;
+        pushFront(slot);
+        if (ttl > 0) {
+            wheel.schedule(slot, ttl);
+        } else {
+            wheel.cancel(slot);
+        }
+    }
+
+    //тик, на котором ключ истечет; 0 - ключа нет или он бессрочный
+    uint64_t expiresAt(int key) const {
+        int32_t slot = table.find(key);
+        if (slot == NONE || !wheel.scheduled(slot)) {
+            return 0;
+        }
+        return wheel.expiresAt(slot);
+    }
+
+    bool erase(int key) {
+        int32_t slot = table.find(key);
+        if (slot == NONE) {
+            return false;
+        }
+        removeSlot(slot);
+        return true;
+    }
+
+    //продвижение часов кэша до tick с удалением всех истекших ключей
+    void advance(uint64_t tick) {
+        wheel.advance(tick, [this](int32_t slot) {
+            //таймер уже снят колесом, остается освободить ячейку
+            unlink(slot);
+            table.erase(slots[slot].key);
+            freeSlots.push_back(slot);
+            count--;
+            expired++;
+        });
+    }
+
+    uint64_t now() const {
+        return wheel.now();
+    }
+
+    long long expiredCount() const {
+        return expired;
+    }
+
+    int size() const {
+        return count;
+    }
+};
+
+#endif
\ No newline at end of file
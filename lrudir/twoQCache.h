@@ -0,0 +1,114 @@
+#ifndef TWO_Q_CACHE_H
+#define TWO_Q_CACHE_H
+
+#include "cachePolicy.h"
+#include "slotLists.h"
+
+//кэш 2Q (Johnson, Shasha): новые ключи попадают в очередь FIFO A1in (1/4 емкости).
+//вытесненные из нее ключи запоминаются в очереди призраков A1out (ключей - половина емкости).
+//только ключ, запрошенный повторно, пока он в A1out, попадает в основной LRU-список Am,
+//поэтому однократные обращения не вытесняют часто используемые ключи
+class TwoQCache : public CachePolicy {
+private:
+    static constexpr int32_t NONE = SlotLists::NONE;
+
+    enum ListId {
+        A1_IN = 0,
+        AM = 1,
+        A1_OUT = 2
+    };
+
+    int capacity;
+    int maxIn;
+    int maxOut;
+    SlotLists nodes;
+    SlotTable table;
+
+    void dropNode(int32_t node) {
+        nodes.unlink(node);
+        table.erase(nodes[node].key);
+        nodes.release(node);
+    }
+
+    //освобождение места под новый ключ
+    void reclaim() {
+        if (nodes.size(A1_IN) + nodes.size(AM) < capacity) {
+            return;
+        }
+
+        if (nodes.size(A1_IN) > maxIn || nodes.size(AM) == 0) {
+            nodes.moveToFront(nodes.back(A1_IN), A1_OUT);
+            if (nodes.size(A1_OUT) > maxOut) {
+                dropNode(nodes.back(A1_OUT));
+            }
+        } else {
+            dropNode(nodes.back(AM));
+        }
+    }
+
+protected:
+    int lookup(int key) override {
+        int32_t node = table.find(key);
+        if (node == NONE || nodes[node].list == A1_OUT) {
+            return -1;
+        }
+        //в A1in порядок не меняется: это FIFO
+        if (nodes[node].list == AM) {
+            nodes.moveToFront(node, AM);
+        }
+        return nodes[node].value;
+    }
+
+    void store(int key, int value) override {
+        int32_t node = table.find(key);
+        if (node != NONE && nodes[node].list != A1_OUT) {
+            nodes[node].value = value;
+            if (nodes[node].list == AM) {
+                nodes.moveToFront(node, AM);
+            }
+            return;
+        }
+
+        if (node != NONE) {
+            //повторное обращение к недавно вытесненному ключу - в основной список
+            nodes.unlink(node);
+            reclaim();
+            nodes[node].value = value;
+            nodes.pushFront(node, AM);
+            return;
+        }
+
+        reclaim();
+        node = nodes.allocate(key, value);
+        table.insert(key, node);
+        nodes.pushFront(node, A1_IN);
+    }
+
+    bool remove(int key) override {
+        int32_t node = table.find(key);
+        if (node == NONE) {
+            return false;
+        }
+        bool resident = nodes[node].list != A1_OUT;
+        dropNode(node);
+        return resident;
+    }
+
+public:
+    TwoQCache(int cap)
+        : capacity(cap > 0 ? cap : 1),
+          maxIn(capacity / 4 > 0 ? capacity / 4 : 1),
+          maxOut(capacity / 2 > 0 ? capacity / 2 : 1),
+          nodes(capacity + maxOut + 1, 3),
+          table(capacity + maxOut + 1) {}
+
+    const char* name() const override {
+        return "2Q";
+    }
+
+    int size() const override {
+        return nodes.size(A1_IN) + nodes.size(AM);
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,260 @@
+#ifndef WEIGHTED_LRU_H
+#define WEIGHTED_LRU_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+//хэш и сравнение ключей кэша. для строк они прозрачные: искать можно по string_view
+//или const char*, не создавая временную строку
+template<typename K>
+struct CacheKeyHash {
+    size_t operator()(const K& key) const {
+        return std::hash<K>()(key);
+    }
+};
+
+template<>
+struct CacheKeyHash<std::string> {
+    size_t operator()(std::string_view key) const {
+        return std::hash<std::string_view>()(key);
+    }
+};
+
+template<typename K>
+struct CacheKeyEqual {
+    bool operator()(const K& a, const K& b) const {
+        return a == b;
+    }
+};
+
+template<>
+struct CacheKeyEqual<std::string> {
+    bool operator()(std::string_view a, std::string_view b) const {
+        return a == b;
+    }
+};
+
+//размер значения в байтах
+inline size_t byteSize(const std::string& value) {
+    return value.size();
+}
+
+template<typename T>
+size_t byteSize(const std::vector<T>& value) {
+    return value.size() * sizeof(T);
+}
+
+template<typename T>
+size_t byteSize(const T&) {
+    return sizeof(T);
+}
+
+//вес записи по умолчанию - байты ключа и значения
+struct ByteWeigher {
+    template<typename K, typename V>
+    size_t operator()(const K& key, const V& value) const {
+        return byteSize(key) + byteSize(value);
+    }
+};
+
+//вес 1 на запись: емкость считается в записях, как в LRUCache
+struct UnitWeigher {
+    template<typename K, typename V>
+    size_t operator()(const K&, const V&) const {
+        return 1;
+    }
+};
+
+//LRU-кэш с произвольными ключами и значениями и емкостью в единицах веса (по умолчанию байтах).
+//записи лежат в deque и не перемещаются, поэтому get возвращает указатель на хранимое
+//значение без копирования; он действителен до удаления или перезаписи этой записи.
+//после вставки записи вытесняются с хвоста, пока суммарный вес больше емкости
+template<typename K, typename V, typename Weigher = ByteWeigher,
+         typename Hash = CacheKeyHash<K>, typename Equal = CacheKeyEqual<K>>
+class WeightedLRUCache {
+private:
+    static constexpr int32_t NONE = -1;
+
+    struct Entry {
+        K key;
+        V value;
+        size_t weight;
+        size_t hash;
+        int32_t prev;
+        int32_t next;
+    };
+
+    size_t capacity;
+    size_t totalWeight;
+    int count;
+    int32_t head;
+    int32_t tail;
+    std::deque<Entry> entries;
+    std::vector<int32_t> freeEntries;
+    std::vector<int32_t> table; //номер записи или NONE, линейное пробирование
+    size_t mask;
+    Weigher weigher;
+    Hash hasher;
+    Equal equal;
+
+    //позиция ключа в таблице либо свободная позиция для вставки
+    template<typename Lookup>
+    size_t findPosition(const Lookup& key, size_t h) const {
+        size_t pos = h & mask;
+        while (table[pos] != NONE) {
+            const Entry& entry = entries[table[pos]];
+            if (entry.hash == h && equal(entry.key, key)) break;
+            pos = (pos + 1) & mask;
+        }
+        return pos;
+    }
+
+    //удаление из таблицы со сдвигом следующих элементов цепочки назад
+    void eraseAt(size_t pos) {
+        size_t next = (pos + 1) & mask;
+        while (table[next] != NONE) {
+            size_t home = entries[table[next]].hash & mask;
+            if (((next - home) & mask) >= ((next - pos) & mask)) {
+                table[pos] = table[next];
+                pos = next;
+            }
+            next = (next + 1) & mask;
+        }
+        table[pos] = NONE;
+    }
+
+    //таблица заполнена не более чем наполовину; при росте записи переставляются заново
+    void growTable() {
+        std::vector<int32_t> old(table.size() * 2, NONE);
+        old.swap(table);
+        mask = table.size() - 1;
+        for (int32_t index : old) {
+            if (index == NONE) continue;
+            size_t pos = entries[index].hash & mask;
+            while (table[pos] != NONE) pos = (pos + 1) & mask;
+            table[pos] = index;
+        }
+    }
+
+    void unlink(int32_t index) {
+        Entry& e = entries[index];
+        if (e.prev != NONE) entries[e.prev].next = e.next; else head = e.next;
+        if (e.next != NONE) entries[e.next].prev = e.prev; else tail = e.prev;
+    }
+
+    void pushFront(int32_t index) {
+        entries[index].prev = NONE;
+        entries[index].next = head;
+        if (head != NONE) entries[head].prev = index;
+        head = index;
+        if (tail == NONE) tail = index;
+    }
+
+    void removeEntry(int32_t index) {
+        Entry& entry = entries[index];
+        eraseAt(findPosition(entry.key, entry.hash));
+        unlink(index);
+        totalWeight -= entry.weight;
+        //память значения освобождается сразу, а не при повторном использовании записи
+        entry.key = K();
+        entry.value = V();
+        freeEntries.push_back(index);
+        count--;
+    }
+
+    void evictToCapacity() {
+        while (totalWeight > capacity && tail != NONE) {
+            removeEntry(tail);
+        }
+    }
+
+public:
+    WeightedLRUCache(size_t capacityWeight)
+        : capacity(capacityWeight), totalWeight(0), count(0), head(NONE), tail(NONE),
+          table(16, NONE), mask(15) {}
+
+    //поиск по ключу или по совместимому с ним типу (string_view для string); nullptr - промах
+    template<typename Lookup>
+    const V* get(const Lookup& key) {
+        size_t h = hasher(key);
+        int32_t index = table[findPosition(key, h)];
+        if (index == NONE) {
+            return nullptr;
+        }
+        if (index != head) {
+            unlink(index);
+            pushFront(index);
+        }
+        return &entries[index].value;
+    }
+
+    const V* get(const char* key) {
+        return get(std::string_view(key));
+    }
+
+    //вставка или замена; запись тяжелее всей емкости не сохраняется
+    void set(K key, V value) {
+        size_t weight = weigher(key, value);
+        size_t h = hasher(key);
+        size_t pos = findPosition(key, h);
+        if (table[pos] != NONE) {
+            removeEntry(table[pos]);
+            pos = findPosition(key, h);
+        }
+        if (weight > capacity) {
+            return;
+        }
+
+        int32_t index;
+        if (!freeEntries.empty()) {
+            index = freeEntries.back();
+            freeEntries.pop_back();
+            entries[index].key = std::move(key);
+            entries[index].value = std::move(value);
+        } else {
+            index = entries.size();
+            entries.push_back(Entry{std::move(key), std::move(value), 0, 0, NONE, NONE});
+        }
+        Entry& entry = entries[index];
+        entry.weight = weight;
+        entry.hash = h;
+        table[pos] = index;
+        pushFront(index);
+        totalWeight += weight;
+        count++;
+
+        if (2 * static_cast<size_t>(count) > table.size()) {
+            growTable();
+        }
+        evictToCapacity();
+    }
+
+    template<typename Lookup>
+    bool erase(const Lookup& key) {
+        int32_t index = table[findPosition(key, hasher(key))];
+        if (index == NONE) {
+            return false;
+        }
+        removeEntry(index);
+        return true;
+    }
+
+    bool erase(const char* key) {
+        return erase(std::string_view(key));
+    }
+
+    int size() const {
+        return count;
+    }
+
+    size_t weight() const {
+        return totalWeight;
+    }
+};
+
+#endif
\ No newline at end of file
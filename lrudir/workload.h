@@ -0,0 +1,59 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+//генератор ключей по закону Ципфа: ключ k (с 0) выпадает с вероятностью ~ 1/(k+1)^alpha
+class ZipfGenerator {
+private:
+    std::vector<double> cdf;
+    std::uniform_real_distribution<double> uniform;
+
+public:
+    ZipfGenerator(int keys, double alpha) : cdf(keys), uniform(0.0, 1.0) {
+        double sum = 0;
+        for (int k = 0; k < keys; k++) {
+            sum += 1.0 / pow(k + 1, alpha);
+            cdf[k] = sum;
+        }
+        for (double& value : cdf) value /= sum;
+    }
+
+    int operator()(std::mt19937& gen) {
+        double u = uniform(gen);
+        return std::min<int>(std::lower_bound(cdf.begin(), cdf.end(), u) - cdf.begin(), cdf.size() - 1);
+    }
+};
+
+//равномерные ключи из [0, keySpace)
+inline std::vector<int> uniformTrace(int operations, int keySpace, std::mt19937& gen) {
+    std::uniform_int_distribution<int> dist(0, keySpace - 1);
+    std::vector<int> trace(operations);
+    for (int& key : trace) key = dist(gen);
+    return trace;
+}
+
+//трасса по Ципфу, в которую через равные промежутки вставлены сканы
+//однократно используемых ключей (вне диапазона горячих)
+inline std::vector<int> scanMixedTrace(int operations, int keySpace, double alpha, int scanLength, int scanEvery, std::mt19937& gen) {
+    ZipfGenerator zipf(keySpace, alpha);
+    std::vector<int> trace;
+    trace.reserve(operations);
+    int nextScanKey = keySpace;
+    while (static_cast<int>(trace.size()) < operations) {
+        if (scanLength > 0 && !trace.empty() && trace.size() % scanEvery == 0) {
+            for (int i = 0; i < scanLength && static_cast<int>(trace.size()) < operations; i++) {
+                trace.push_back(nextScanKey++);
+            }
+        }
+        if (static_cast<int>(trace.size()) < operations) {
+            trace.push_back(zipf(gen));
+        }
+    }
+    return trace;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,395 @@
+#include "hamtSet.h"
+#include <unordered_set>
+#include <functional>
+
+using namespace std;
+
+//число бит хэша на один уровень дерева
+const int HAMT_BITS = 5;
+
+//обратимое перемешивание: разные ключи всегда дают разные хэши, коллизий не бывает
+uint32_t hamtHash(int key) {
+    uint32_t h = static_cast<uint32_t>(key);
+    h ^= h >> 16;
+    h *= 0x85EBCA6BU;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35U;
+    h ^= h >> 16;
+    return h;
+}
+
+//бит позиции ключа на уровне shift
+uint32_t hamtBit(uint32_t hash, int shift) {
+    return 1U << ((hash >> shift) & 31);
+}
+
+//номер элемента в плотном массиве по биту позиции
+int hamtIndex(uint32_t map, uint32_t bit) {
+    return __builtin_popcount(map & (bit - 1));
+}
+
+//сборка нового узла по позициям в порядке возрастания
+struct HamtBuilder {
+    HamtNode node{0, 0, 0, {}, {}};
+
+    void addKey(uint32_t bit, int key) {
+        node.dataMap |= bit;
+        node.keys.push_back(key);
+        node.count++;
+    }
+
+    //поддерево из одного ключа хранится прямо в родителе - так форма дерева однозначна
+    void addChild(uint32_t bit, const HamtNodePtr& child) {
+        if (!child) return;
+        if (child->count == 1 && child->children.empty()) {
+            addKey(bit, child->keys[0]);
+            return;
+        }
+        node.nodeMap |= bit;
+        node.children.push_back(child);
+        node.count += child->count;
+    }
+
+    //копирование содержимого позиции bit из узла source
+    void copyFrom(const HamtNode* source, uint32_t bit) {
+        if (source->dataMap & bit) {
+            addKey(bit, source->keys[hamtIndex(source->dataMap, bit)]);
+        } else if (source->nodeMap & bit) {
+            addChild(bit, source->children[hamtIndex(source->nodeMap, bit)]);
+        }
+    }
+
+    HamtNodePtr build() {
+        if (node.count == 0) return nullptr;
+        return make_shared<const HamtNode>(move(node));
+    }
+};
+
+//копия узла, в которой позиция bit заменена ключом или поддеревом
+HamtNodePtr rebuildAt(const HamtNode* node, uint32_t bit, bool isKey, int key, const HamtNodePtr& child) {
+    HamtBuilder builder;
+    for (int i = 0; i < 32; i++) {
+        uint32_t current = 1U << i;
+        if (current != bit) {
+            if (node) builder.copyFrom(node, current);
+        } else if (isKey) {
+            builder.addKey(bit, key);
+        } else {
+            builder.addChild(bit, child);
+        }
+    }
+    return builder.build();
+}
+
+//поддерево из двух ключей с разными хэшами
+HamtNodePtr mergeTwoKeys(int key1, uint32_t hash1, int key2, uint32_t hash2, int shift) {
+    uint32_t bit1 = hamtBit(hash1, shift);
+    uint32_t bit2 = hamtBit(hash2, shift);
+    HamtBuilder builder;
+
+    if (bit1 == bit2) {
+        builder.addChild(bit1, mergeTwoKeys(key1, hash1, key2, hash2, shift + HAMT_BITS));
+    } else if (bit1 < bit2) {
+        builder.addKey(bit1, key1);
+        builder.addKey(bit2, key2);
+    } else {
+        builder.addKey(bit2, key2);
+        builder.addKey(bit1, key1);
+    }
+    return builder.build();
+}
+
+bool containsNode(const HamtNode* node, int key, uint32_t hash, int shift) {
+    while (node) {
+        uint32_t bit = hamtBit(hash, shift);
+        if (node->dataMap & bit) {
+            return node->keys[hamtIndex(node->dataMap, bit)] == key;
+        }
+        if (!(node->nodeMap & bit)) {
+            return false;
+        }
+        node = node->children[hamtIndex(node->nodeMap, bit)].get();
+        shift += HAMT_BITS;
+    }
+    return false;
+}
+
+//вставка с копированием пути; если ключ уже есть, возвращается тот же узел
+HamtNodePtr insertNode(const HamtNodePtr& node, int key, uint32_t hash, int shift) {
+    uint32_t bit = hamtBit(hash, shift);
+    if (!node) return rebuildAt(nullptr, bit, true, key, nullptr);
+
+    if (node->dataMap & bit) {
+        int existing = node->keys[hamtIndex(node->dataMap, bit)];
+        if (existing == key) return node;
+        HamtNodePtr child = mergeTwoKeys(existing, hamtHash(existing), key, hash, shift + HAMT_BITS);
+        return rebuildAt(node.get(), bit, false, 0, child);
+    }
+
+    if (node->nodeMap & bit) {
+        const HamtNodePtr& child = node->children[hamtIndex(node->nodeMap, bit)];
+        HamtNodePtr updated = insertNode(child, key, hash, shift + HAMT_BITS);
+        if (updated == child) return node;
+        return rebuildAt(node.get(), bit, false, 0, updated);
+    }
+
+    return rebuildAt(node.get(), bit, true, key, nullptr);
+}
+
+//удаление с копированием пути; если ключа нет, возвращается тот же узел
+HamtNodePtr removeNode(const HamtNodePtr& node, int key, uint32_t hash, int shift) {
+    if (!node) return node;
+    uint32_t bit = hamtBit(hash, shift);
+
+    if (node->dataMap & bit) {
+        if (node->keys[hamtIndex(node->dataMap, bit)] != key) return node;
+        return rebuildAt(node.get(), bit, false, 0, nullptr);
+    }
+
+    if (node->nodeMap & bit) {
+        const HamtNodePtr& child = node->children[hamtIndex(node->nodeMap, bit)];
+        HamtNodePtr updated = removeNode(child, key, hash, shift + HAMT_BITS);
+        if (updated == child) return node;
+        return rebuildAt(node.get(), bit, false, 0, updated);
+    }
+
+    return node;
+}
+
+//объединение: совпадающие поддеревья и позиции, занятые только одним операндом, не копируются
+HamtNodePtr unionNodes(const HamtNodePtr& a, const HamtNodePtr& b, int shift) {
+    if (a == b || !b) return a;
+    if (!a) return b;
+
+    HamtBuilder builder;
+    bool sameAsA = true, sameAsB = true;
+
+    for (int i = 0; i < 32; i++) {
+        uint32_t bit = 1U << i;
+        bool aKey = a->dataMap & bit, aNode = a->nodeMap & bit;
+        bool bKey = b->dataMap & bit, bNode = b->nodeMap & bit;
+
+        if (!aKey && !aNode) {
+            if (bKey || bNode) sameAsA = false;
+            builder.copyFrom(b.get(), bit);
+        } else if (!bKey && !bNode) {
+            sameAsB = false;
+            builder.copyFrom(a.get(), bit);
+        } else if (aKey && bKey) {
+            int keyA = a->keys[hamtIndex(a->dataMap, bit)];
+            int keyB = b->keys[hamtIndex(b->dataMap, bit)];
+            if (keyA == keyB) {
+                builder.addKey(bit, keyA);
+            } else {
+                builder.addChild(bit, mergeTwoKeys(keyA, hamtHash(keyA), keyB, hamtHash(keyB), shift + HAMT_BITS));
+                sameAsA = sameAsB = false;
+            }
+        } else if (aKey || bKey) {
+            //ключ одного операнда добавляется в поддерево другого
+            const HamtNode* keySide = aKey ? a.get() : b.get();
+            const HamtNode* nodeSide = aKey ? b.get() : a.get();
+            int key = keySide->keys[hamtIndex(keySide->dataMap, bit)];
+            const HamtNodePtr& child = nodeSide->children[hamtIndex(nodeSide->nodeMap, bit)];
+            HamtNodePtr merged = insertNode(child, key, hamtHash(key), shift + HAMT_BITS);
+            builder.addChild(bit, merged);
+            if (aKey || merged != child) sameAsA = false;
+            if (bKey || merged != child) sameAsB = false;
+        } else {
+            const HamtNodePtr& childA = a->children[hamtIndex(a->nodeMap, bit)];
+            const HamtNodePtr& childB = b->children[hamtIndex(b->nodeMap, bit)];
+            HamtNodePtr merged = unionNodes(childA, childB, shift + HAMT_BITS);
+            builder.addChild(bit, merged);
+            if (merged != childA) sameAsA = false;
+            if (merged != childB) sameAsB = false;
+        }
+    }
+
+    if (sameAsA) return a;
+    if (sameAsB) return b;
+    return builder.build();
+}
+
+//пересечение: результат - подмножество обоих операндов, поэтому может совпасть с любым из них
+HamtNodePtr intersectNodes(const HamtNodePtr& a, const HamtNodePtr& b, int shift) {
+    if (!a || !b) return nullptr;
+    if (a == b) return a;
+
+    HamtBuilder builder;
+    bool sameAsA = true, sameAsB = true;
+
+    for (int i = 0; i < 32; i++) {
+        uint32_t bit = 1U << i;
+        bool aKey = a->dataMap & bit, aNode = a->nodeMap & bit;
+        bool bKey = b->dataMap & bit, bNode = b->nodeMap & bit;
+
+        if (!aKey && !aNode) {
+            if (bKey || bNode) sameAsB = false;
+        } else if (!bKey && !bNode) {
+            sameAsA = false;
+        } else if (aKey || bKey) {
+            //ключ остается, если второй операнд его содержит
+            const HamtNode* keySide = aKey ? a.get() : b.get();
+            const HamtNode* otherSide = aKey ? b.get() : a.get();
+            int key = keySide->keys[hamtIndex(keySide->dataMap, bit)];
+            bool shared;
+            if (otherSide->dataMap & bit) {
+                shared = otherSide->keys[hamtIndex(otherSide->dataMap, bit)] == key;
+            } else {
+                shared = containsNode(otherSide->children[hamtIndex(otherSide->nodeMap, bit)].get(),
+                                      key, hamtHash(key), shift + HAMT_BITS);
+            }
+            if (shared) {
+                builder.addKey(bit, key);
+                if (!aKey) sameAsA = false;
+                if (!bKey) sameAsB = false;
+            } else {
+                sameAsA = sameAsB = false;
+            }
+        } else {
+            const HamtNodePtr& childA = a->children[hamtIndex(a->nodeMap, bit)];
+            const HamtNodePtr& childB = b->children[hamtIndex(b->nodeMap, bit)];
+            HamtNodePtr common = intersectNodes(childA, childB, shift + HAMT_BITS);
+            builder.addChild(bit, common);
+            if (common != childA) sameAsA = false;
+            if (common != childB) sameAsB = false;
+        }
+    }
+
+    if (sameAsA) return a;
+    if (sameAsB) return b;
+    return builder.build();
+}
+
+//разность: нетронутые поддеревья уменьшаемого переходят в результат без копирования
+HamtNodePtr differenceNodes(const HamtNodePtr& a, const HamtNodePtr& b, int shift) {
+    if (!a || !b) return a;
+    if (a == b) return nullptr;
+
+    HamtBuilder builder;
+    bool sameAsA = true;
+
+    for (int i = 0; i < 32; i++) {
+        uint32_t bit = 1U << i;
+        bool bKey = b->dataMap & bit, bNode = b->nodeMap & bit;
+
+        if (a->dataMap & bit) {
+            int key = a->keys[hamtIndex(a->dataMap, bit)];
+            bool removed = (bKey && b->keys[hamtIndex(b->dataMap, bit)] == key) ||
+                           (bNode && containsNode(b->children[hamtIndex(b->nodeMap, bit)].get(),
+                                                  key, hamtHash(key), shift + HAMT_BITS));
+            if (removed) {
+                sameAsA = false;
+            } else {
+                builder.addKey(bit, key);
+            }
+        } else if (a->nodeMap & bit) {
+            const HamtNodePtr& child = a->children[hamtIndex(a->nodeMap, bit)];
+            HamtNodePtr rest = child;
+            if (bKey) {
+                int key = b->keys[hamtIndex(b->dataMap, bit)];
+                rest = removeNode(child, key, hamtHash(key), shift + HAMT_BITS);
+            } else if (bNode) {
+                rest = differenceNodes(child, b->children[hamtIndex(b->nodeMap, bit)], shift + HAMT_BITS);
+            }
+            builder.addChild(bit, rest);
+            if (rest != child) sameAsA = false;
+        }
+    }
+
+    if (sameAsA) return a;
+    return builder.build();
+}
+
+//создание пустого множества
+void createSet(PersistentSet* set) {
+    set->root = nullptr;
+}
+
+//добавление элемента
+bool insert(PersistentSet* set, int key) {
+    HamtNodePtr updated = insertNode(set->root, key, hamtHash(key), 0);
+    if (updated == set->root) return false;
+    set->root = updated;
+    return true;
+}
+
+//проверка наличия элемента
+bool contains(const PersistentSet* set, int key) {
+    return containsNode(set->root.get(), key, hamtHash(key), 0);
+}
+
+//удаление элемента
+bool remove(PersistentSet* set, int key) {
+    HamtNodePtr updated = removeNode(set->root, key, hamtHash(key), 0);
+    if (updated == set->root) return false;
+    set->root = updated;
+    return true;
+}
+
+//размер множества хранится в корне
+int size(const PersistentSet* set) {
+    return set->root ? set->root->count : 0;
+}
+
+bool empty(const PersistentSet* set) {
+    return !set->root;
+}
+
+//снимок версии: разделяет с исходным множеством все узлы
+PersistentSet snapshot(const PersistentSet* set) {
+    return PersistentSet{set->root};
+}
+
+PersistentSet unionSets(const PersistentSet* set1, const PersistentSet* set2) {
+    return PersistentSet{unionNodes(set1->root, set2->root, 0)};
+}
+
+PersistentSet intersection(const PersistentSet* set1, const PersistentSet* set2) {
+    return PersistentSet{intersectNodes(set1->root, set2->root, 0)};
+}
+
+PersistentSet difference(const PersistentSet* set1, const PersistentSet* set2) {
+    return PersistentSet{differenceNodes(set1->root, set2->root, 0)};
+}
+
+//преобразование хэш-множества в персистентное
+PersistentSet toPersistentSet(const Set* set) {
+    PersistentSet result;
+    createSet(&result);
+    for (int key : setToVector(set)) {
+        insert(&result, key);
+    }
+    return result;
+}
+
+//преобразование персистентного множества в вектор
+vector<int> setToVector(const PersistentSet* set) {
+    vector<int> result;
+    function<void(const HamtNode*)> collect = [&](const HamtNode* node) {
+        result.insert(result.end(), node->keys.begin(), node->keys.end());
+        for (const HamtNodePtr& child : node->children) {
+            collect(child.get());
+        }
+    };
+    if (set->root) collect(set->root.get());
+    return result;
+}
+
+//память, занятая всеми версиями вместе: каждый общий узел учитывается один раз
+size_t sharedMemoryUsage(const vector<PersistentSet>& versions) {
+    unordered_set<const HamtNode*> visited;
+    size_t bytes = 0;
+    function<void(const HamtNode*)> visit = [&](const HamtNode* node) {
+        if (!visited.insert(node).second) return;
+        //узел вместе с блоком управления shared_ptr и содержимым векторов
+        bytes += sizeof(HamtNode) + 2 * sizeof(long) + node->keys.capacity() * sizeof(int) +
+                 node->children.capacity() * sizeof(HamtNodePtr);
+        for (const HamtNodePtr& child : node->children) {
+            visit(child.get());
+        }
+    };
+    for (const PersistentSet& version : versions) {
+        if (version.root) visit(version.root.get());
+    }
+    return bytes;
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#ifndef HAMT_SET_H
+#define HAMT_SET_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include "set.h"
+
+//узел префиксного дерева хэшей (HAMT): 32 позиции, в каждой либо ключ, либо поддерево.
+//узлы неизменяемы, поэтому версии множества разделяют все нетронутые поддеревья
+struct HamtNode {
+    uint32_t dataMap; //позиции, в которых лежат ключи
+    uint32_t nodeMap; //позиции, в которых лежат поддеревья
+    int count;        //число ключей в поддереве
+    std::vector<int> keys;
+    std::vector<std::shared_ptr<const HamtNode>> children;
+};
+
+typedef std::shared_ptr<const HamtNode> HamtNodePtr;
+
+//персистентное множество: копирование - это O(1) снимок версии.
+//это отдельный вариант для программ, которые держат много версий в памяти (см. setBench).
+//setMain и SetStore по-прежнему хранят Set: каждая команда - отдельный процесс, который
+//загружает и сохраняет базу целиком, поэтому общие поддеревья не пережили бы запуск,
+//а сводки, упорядоченный индекс, кодек и выражения работают с Set
+struct PersistentSet {
+    HamtNodePtr root; //nullptr для пустого множества
+};
+
+//базовые операции персистентного множества (изменяют только свою версию)
+void createSet(PersistentSet* set);
+bool insert(PersistentSet* set, int key);
+bool contains(const PersistentSet* set, int key);
+bool remove(PersistentSet* set, int key);
+int size(const PersistentSet* set);
+bool empty(const PersistentSet* set);
+PersistentSet snapshot(const PersistentSet* set);
+
+//операции с множествами: результат разделяет неизмененные поддеревья с операндами
+PersistentSet unionSets(const PersistentSet* set1, const PersistentSet* set2);
+PersistentSet intersection(const PersistentSet* set1, const PersistentSet* set2);
+PersistentSet difference(const PersistentSet* set1, const PersistentSet* set2);
+
+//преобразования и учет памяти
+PersistentSet toPersistentSet(const Set* set);
+std::vector<int> setToVector(const PersistentSet* set);
+size_t sharedMemoryUsage(const std::vector<PersistentSet>& versions);
+
+#endif
\ No newline at end of file
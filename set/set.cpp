@@ -6,6 +6,12 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
+#include <cmath>
+#include <unordered_set>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <atomic>
 
 using namespace std;
 
@@ -15,6 +21,142 @@ int hashFunction(int key, int tableSize) {
     return hasher(key) % tableSize;
 }
 
+//перемешивание битов ключа для сводок (splitmix64)
+uint64_t sketchHash(int key) {
+    uint64_t x = static_cast<uint64_t>(static_cast<uint32_t>(key)) + 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+//сброс сводки в состояние пустого множества
+void resetSketch(SetSketch* sketch) {
+    fill(sketch->registers, sketch->registers + HLL_REGISTERS, 0);
+    sketch->minHashCount = 0;
+    sketch->stale = false;
+}
+
+//учет нового элемента в сводке
+void updateSketch(SetSketch* sketch, int key) {
+    uint64_t h = sketchHash(key);
+
+    //HyperLogLog: старшие биты выбирают регистр, в нем храним позицию первой единицы
+    int reg = h >> (64 - HLL_PRECISION);
+    uint64_t rest = (h << HLL_PRECISION) | (1ULL << (HLL_PRECISION - 1));
+    uint8_t rank = __builtin_clzll(rest) + 1;
+    if (rank > sketch->registers[reg]) {
+        sketch->registers[reg] = rank;
+    }
+
+    //bottom-k: храним MINHASH_SIZE наименьших хэшей
+    int count = sketch->minHashCount;
+    if (count == MINHASH_SIZE && h >= sketch->minHashes[count - 1]) return;
+    uint64_t* end = sketch->minHashes + count;
+    uint64_t* pos = lower_bound(sketch->minHashes, end, h);
+    if (pos != end && *pos == h) return;
+    if (count == MINHASH_SIZE) {
+        end--;
+    } else {
+        sketch->minHashCount++;
+    }
+    copy_backward(pos, end, end + 1);
+    *pos = h;
+}
+
+//пересчет сводки по всем элементам, если после удалений она устарела
+void refreshSketch(const Set* set) {
+    if (!set->sketch->stale) return;
+    resetSketch(set->sketch);
+    for (int i = 0; i < set->tableSize; i++) {
+        for (NodeSet* current = set->buckets[i]; current != nullptr; current = current->next) {
+            updateSketch(set->sketch, current->key);
+        }
+    }
+}
+
+//перестройка дерева Фенвика по размерам блоков за O(числа блоков)
+void rebuildOrderedCounts(OrderedIndex* index) {
+    const auto& blocks = index->blocks;
+    auto& counts = index->counts;
+    counts.assign(blocks.size() + 1, 0);
+    for (size_t i = 1; i < counts.size(); i++) {
+        counts[i] += blocks[i - 1].size();
+        size_t parent = i + (i & (0 - i));
+        if (parent < counts.size()) counts[parent] += counts[i];
+    }
+}
+
+//изменение размера блока b на delta без деления и слияния блоков
+void addOrderedCount(OrderedIndex* index, size_t b, int delta) {
+    for (size_t i = b + 1; i < index->counts.size(); i += i & (0 - i)) {
+        index->counts[i] += delta;
+    }
+}
+
+//число элементов в блоках до блока b
+int orderedCountBefore(const OrderedIndex* index, size_t b) {
+    int result = 0;
+    for (size_t i = b; i > 0; i -= i & (0 - i)) {
+        result += index->counts[i];
+    }
+    return result;
+}
+
+//поиск блока, в котором находится или должен находиться key
+size_t findOrderedBlock(const OrderedIndex* index, int key) {
+    const auto& blocks = index->blocks;
+    auto it = lower_bound(blocks.begin(), blocks.end(), key,
+                          [](const vector<int>& block, int value) { return block.back() < value; });
+    if (it == blocks.end()) return blocks.size() - 1;
+    return it - blocks.begin();
+}
+
+//добавление ключа в упорядоченный индекс (ключа там еще нет)
+void orderedInsert(OrderedIndex* index, int key) {
+    auto& blocks = index->blocks;
+    if (blocks.empty()) {
+        blocks.push_back({key});
+        rebuildOrderedCounts(index);
+        return;
+    }
+
+    size_t b = findOrderedBlock(index, key);
+    vector<int>& block = blocks[b];
+    block.insert(lower_bound(block.begin(), block.end(), key), key);
+
+    //переполненный блок делим пополам; сдвиг блоков и так стоит O(числа блоков)
+    if (block.size() > ORDERED_BLOCK_SIZE) {
+        vector<int> upper(block.begin() + block.size() / 2, block.end());
+        block.resize(block.size() / 2);
+        blocks.insert(blocks.begin() + b + 1, move(upper));
+        rebuildOrderedCounts(index);
+    } else {
+        addOrderedCount(index, b, 1);
+    }
+}
+
+//удаление ключа из упорядоченного индекса
+void orderedRemove(OrderedIndex* index, int key) {
+    auto& blocks = index->blocks;
+    size_t b = findOrderedBlock(index, key);
+    vector<int>& block = blocks[b];
+    auto pos = lower_bound(block.begin(), block.end(), key);
+    if (pos == block.end() || *pos != key) return;
+    block.erase(pos);
+
+    //пустой блок убираем, маленький сливаем с соседом
+    if (block.empty()) {
+        blocks.erase(blocks.begin() + b);
+        rebuildOrderedCounts(index);
+    } else if (b + 1 < blocks.size() && block.size() + blocks[b + 1].size() <= ORDERED_BLOCK_SIZE / 2) {
+        block.insert(block.end(), blocks[b + 1].begin(), blocks[b + 1].end());
+        blocks.erase(blocks.begin() + b + 1);
+        rebuildOrderedCounts(index);
+    } else {
+        addOrderedCount(index, b, -1);
+    }
+}
+
 //создание множества
 void createSet(Set* set, int initialSize) {
     set->tableSize = initialSize;
@@ -23,13 +165,20 @@ void createSet(Set* set, int initialSize) {
     for (int i = 0; i < initialSize; i++) {
         set->buckets[i] = nullptr;
     }
+    set->sketch = new SetSketch;
+    resetSketch(set->sketch);
+    set->order = nullptr;
 }
 
 //уничтожение множества
 void destroySet(Set* set) {
     clear(set);
     delete[] set->buckets;
+    delete set->sketch;
+    delete set->order;
     set->buckets = nullptr;
+    set->sketch = nullptr;
+    set->order = nullptr;
     set->tableSize = 0;
     set->itemCount = 0;
 }
@@ -73,6 +222,12 @@ bool insert(Set* set, int key) {
     NodeSet* newNode = new NodeSet{key, set->buckets[index]};
     set->buckets[index] = newNode;
     set->itemCount++;
+    if (!set->sketch->stale) {
+        updateSketch(set->sketch, key);
+    }
+    if (set->order) {
+        orderedInsert(set->order, key);
+    }
     
     rehashIfNeeded(set);
     return true;
@@ -107,6 +262,11 @@ bool remove(Set* set, int key) {
             }
             delete current;
             set->itemCount--;
+            //из сводок удалить элемент нельзя, перестроим их при следующем запросе
+            set->sketch->stale = true;
+            if (set->order) {
+                orderedRemove(set->order, key);
+            }
             return true;
         }
         prev = current;
@@ -137,6 +297,13 @@ void clear(Set* set) {
         set->buckets[i] = nullptr;
     }
     set->itemCount = 0;
+    if (set->sketch) {
+        resetSketch(set->sketch);
+    }
+    if (set->order) {
+        set->order->blocks.clear();
+        set->order->counts.clear();
+    }
 }
 
 //объединение множеств
@@ -220,11 +387,168 @@ bool isSubset(const Set* set1, const Set* set2) {
     return true;
 }
 
-//вывод множества
+//оценка мощности по регистрам HyperLogLog
+double hllEstimate(const uint8_t* registers) {
+    const double m = HLL_REGISTERS;
+    double sum = 0;
+    int zeros = 0;
+    for (int i = 0; i < HLL_REGISTERS; i++) {
+        sum += ldexp(1.0, -registers[i]);
+        if (registers[i] == 0) zeros++;
+    }
+
+    double estimate = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+    //на малых мощностях точнее линейный подсчет
+    if (estimate <= 2.5 * m && zeros > 0) {
+        estimate = m * log(m / zeros);
+    }
+    return estimate;
+}
+
+//оценка мощности множества
+double estimateCardinality(const Set* set) {
+    refreshSketch(set);
+    return hllEstimate(set->sketch->registers);
+}
+
+//оценка мощности объединения: регистры HyperLogLog объединяются поэлементным максимумом
+double estimateUnionCardinality(const Set* set1, const Set* set2) {
+    refreshSketch(set1);
+    refreshSketch(set2);
+    uint8_t merged[HLL_REGISTERS];
+    for (int i = 0; i < HLL_REGISTERS; i++) {
+        merged[i] = max(set1->sketch->registers[i], set2->sketch->registers[i]);
+    }
+    return hllEstimate(merged);
+}
+
+//оценка коэффициента Жаккара: доля общих хэшей среди k наименьших хэшей объединения
+double estimateJaccard(const Set* set1, const Set* set2) {
+    refreshSketch(set1);
+    refreshSketch(set2);
+    const SetSketch* a = set1->sketch;
+    const SetSketch* b = set2->sketch;
+
+    int i = 0, j = 0, taken = 0, shared = 0;
+    while (taken < MINHASH_SIZE && (i < a->minHashCount || j < b->minHashCount)) {
+        if (j == b->minHashCount || (i < a->minHashCount && a->minHashes[i] < b->minHashes[j])) {
+            i++;
+        } else if (i == a->minHashCount || b->minHashes[j] < a->minHashes[i]) {
+            j++;
+        } else {
+            shared++;
+            i++;
+            j++;
+        }
+        taken++;
+    }
+    return taken == 0 ? 0.0 : static_cast<double>(shared) / taken;
+}
+
+//включение упорядоченного индекса по уже отсортированным элементам: режем на полублоки,
+//чтобы вставки не сразу вызывали деление
+void enableOrderedIndexSorted(Set* set, const vector<int>& sortedKeys) {
+    if (set->order) return;
+
+    set->order = new OrderedIndex;
+    const size_t step = ORDERED_BLOCK_SIZE / 2;
+    for (size_t i = 0; i < sortedKeys.size(); i += step) {
+        size_t end = min(sortedKeys.size(), i + step);
+        set->order->blocks.emplace_back(sortedKeys.begin() + i, sortedKeys.begin() + end);
+    }
+    rebuildOrderedCounts(set->order);
+}
+
+//включение упорядоченного индекса: текущие элементы сортируются один раз
+void enableOrderedIndex(Set* set) {
+    if (set->order) return;
+
+    vector<int> keys = setToVector(set);
+    sort(keys.begin(), keys.end());
+    enableOrderedIndexSorted(set, keys);
+}
+
+//отключение упорядоченного индекса
+void disableOrderedIndex(Set* set) {
+    delete set->order;
+    set->order = nullptr;
+}
+
+//элементы из отрезка [low, high] по возрастанию
+vector<int> rangeQuery(const Set* set, int low, int high) {
+    vector<int> result;
+    if (!set->order || set->order->blocks.empty() || low > high) return result;
+
+    const auto& blocks = set->order->blocks;
+    size_t first = findOrderedBlock(set->order, low);
+    for (size_t b = first; b < blocks.size(); b++) {
+        auto it = (b == first) ? lower_bound(blocks[b].begin(), blocks[b].end(), low)
+                               : blocks[b].begin();
+        for (; it != blocks[b].end(); ++it) {
+            if (*it > high) return result;
+            result.push_back(*it);
+        }
+    }
+    return result;
+}
+
+//наименьший элемент
+bool minElement(const Set* set, int& result) {
+    if (!set->order || set->order->blocks.empty()) return false;
+    result = set->order->blocks.front().front();
+    return true;
+}
+
+//наибольший элемент
+bool maxElement(const Set* set, int& result) {
+    if (!set->order || set->order->blocks.empty()) return false;
+    result = set->order->blocks.back().back();
+    return true;
+}
+
+//число элементов, меньших key
+int rankOf(const Set* set, int key) {
+    if (!set->order || set->order->blocks.empty()) return 0;
+
+    const auto& blocks = set->order->blocks;
+    size_t b = findOrderedBlock(set->order, key);
+    return orderedCountBefore(set->order, b) +
+           (lower_bound(blocks[b].begin(), blocks[b].end(), key) - blocks[b].begin());
+}
+
+//все элементы по возрастанию
+vector<int> sortedElements(const Set* set) {
+    if (!set->order) {
+        vector<int> keys = setToVector(set);
+        sort(keys.begin(), keys.end());
+        return keys;
+    }
+
+    vector<int> result;
+    result.reserve(set->itemCount);
+    for (const auto& block : set->order->blocks) {
+        result.insert(result.end(), block.begin(), block.end());
+    }
+    return result;
+}
+
+//вывод множества (по возрастанию, если включен упорядоченный индекс)
 void printSet(const Set* set) {
     cout << "{";
     bool first = true;
     
+    if (set->order) {
+        for (int key : sortedElements(set)) {
+            if (!first) {
+                cout << ", ";
+            }
+            cout << key;
+            first = false;
+        }
+        cout << "}" << endl;
+        return;
+    }
+
     for (int i = 0; i < set->tableSize; i++) {
         NodeSet* current = set->buckets[i];
         while (current != nullptr) {
@@ -247,12 +571,9 @@ void saveSetToFile(const Set* set, const string& filename) {
         return;
     }
     
-    for (int i = 0; i < set->tableSize; i++) {
-        NodeSet* current = set->buckets[i];
-        while (current != nullptr) {
-            file << current->key << endl;
-            current = current->next;
-        }
+    //порядок записи совпадает с setToVector: по возрастанию при упорядоченном индексе
+    for (int key : setToVector(set)) {
+        file << key << endl;
     }
     
     file.close();
@@ -276,8 +597,12 @@ void loadSetFromFile(Set* set, const string& filename) {
     file.close();
 }
 
-//преобразование множества в вектор
+//преобразование множества в вектор (по возрастанию, если включен упорядоченный индекс)
 vector<int> setToVector(const Set* set) {
+    if (set->order) {
+        return sortedElements(set);
+    }
+
     vector<int> result;
     for (int i = 0; i < set->tableSize; i++) {
         NodeSet* current = set->buckets[i];
@@ -335,8 +660,312 @@ bool partitionBacktrack(vector<int>& nums, vector<vector<int>>& subsets,
     return false;
 }
 
+//разбиение динамикой по битовым маскам: reachable[mask] == true, если элементы mask
+//можно разложить так, что все подмножества, кроме последнего, заполнены до target,
+//а последнее не переполнено; остаток последнего однозначно равен sum(mask) % target
+bool partitionBitmaskDP(const vector<int>& nums, int target, int k, vector<vector<int>>& subsets) {
+    int n = nums.size();
+    size_t full = (size_t(1) << n) - 1;
+    vector<bool> reachable(full + 1, false);
+    reachable[0] = true;
+
+    for (size_t mask = 0; mask < full; mask++) {
+        if (!reachable[mask]) continue;
+
+        long long sum = 0;
+        for (int i = 0; i < n; i++) {
+            if (mask & (size_t(1) << i)) sum += nums[i];
+        }
+        int rem = sum % target;
+
+        for (int i = 0; i < n; i++) {
+            if (mask & (size_t(1) << i)) continue;
+            if (rem + nums[i] > target) continue;
+            reachable[mask | (size_t(1) << i)] = true;
+            //новое подмножество всегда начинаем с первого свободного (наибольшего) элемента
+            if (rem == 0) break;
+        }
+    }
+
+    if (!reachable[full]) return false;
+
+    //восстанавливаем порядок добавления элементов, идя от полной маски назад
+    vector<int> order;
+    long long sum = 0;
+    for (int num : nums) sum += num;
+
+    size_t mask = full;
+    while (mask != 0) {
+        for (int i = 0; i < n; i++) {
+            size_t bit = size_t(1) << i;
+            if (!(mask & bit) || !reachable[mask ^ bit]) continue;
+
+            size_t prev = mask ^ bit;
+            int prevRem = (sum - nums[i]) % target;
+            if (prevRem + nums[i] > target) continue;
+            if (prevRem == 0) {
+                //переход из prev с нулевым остатком возможен только по первому свободному элементу
+                int firstFree = 0;
+                while (prev & (size_t(1) << firstFree)) firstFree++;
+                if (firstFree != i) continue;
+            }
+
+            order.push_back(i);
+            sum -= nums[i];
+            mask = prev;
+            break;
+        }
+    }
+
+    //раскладываем элементы по подмножествам по накопленной сумме
+    subsets.assign(k, vector<int>());
+    long long prefix = 0;
+    for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        int bucket = min<long long>(prefix / target, k - 1);
+        subsets[bucket].push_back(nums[*it]);
+        prefix += nums[*it];
+    }
+    return true;
+}
+
+//общая таблица неудачных состояний (индекс, мультимножество сумм подмножеств),
+//разделенная на сегменты со своими мьютексами, чтобы потоки реже ждали друг друга
+class FailedPartitionStates {
+private:
+    static const int SHARDS = 16;
+    static const size_t MAX_STATES_PER_SHARD = 1 << 18;
+    unordered_set<string> states[SHARDS];
+    mutex locks[SHARDS];
+
+    int shardOf(const string& key) const {
+        return hash<string>{}(key) % SHARDS;
+    }
+
+public:
+    bool contains(const string& key) {
+        int shard = shardOf(key);
+        lock_guard<mutex> guard(locks[shard]);
+        return states[shard].count(key) > 0;
+    }
+
+    void add(const string& key) {
+        int shard = shardOf(key);
+        lock_guard<mutex> guard(locks[shard]);
+        if (states[shard].size() < MAX_STATES_PER_SHARD) {
+            states[shard].insert(key);
+        }
+    }
+};
+
+//состояние поиска: сколько чисел уже разложено и куда
+struct PartitionTask {
+    int index;
+    vector<int> sums;  //текущие суммы подмножеств
+    vector<int> owner; //owner[i] - номер подмножества для nums[i]
+    int donated;       //сколько ветвей этой задачи отдано другим потокам
+};
+
+//запоминаем только состояния, у которых осталось не меньше стольких чисел
+const int PARTITION_MEMO_MIN_REMAINING = 8;
+//ветви отдаются простаивающим потокам, только если в них осталось не меньше стольких чисел
+const int PARTITION_SPLIT_MIN_REMAINING = 12;
+
+//очереди задач потоков: своя очередь берется с конца, чужие крадутся с начала.
+//idle - число потоков, не нашедших задачу; пока оно не ноль, занятые потоки отдают
+//непроверенные ветви своих узлов, так что большая задача делится и после раздачи.
+//active - число потоков, которые держат задачу и еще могут отдать ветви
+struct PartitionQueues {
+    vector<deque<PartitionTask>> queues;
+    vector<mutex> locks;
+    atomic<int> idle;
+    atomic<int> active;
+
+    PartitionQueues(int threads) : queues(threads), locks(threads), idle(0), active(0) {}
+
+    void push(int self, PartitionTask task) {
+        lock_guard<mutex> guard(locks[self]);
+        queues[self].push_back(move(task));
+    }
+
+    bool take(int self, PartitionTask& task) {
+        int threads = queues.size();
+        for (int i = 0; i < threads; i++) {
+            int victim = (self + i) % threads;
+            lock_guard<mutex> guard(locks[victim]);
+            if (queues[victim].empty()) continue;
+            if (victim == self) {
+                task = move(queues[victim].back());
+                queues[victim].pop_back();
+            } else {
+                task = move(queues[victim].front());
+                queues[victim].pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+};
+
+//ключ состояния не зависит от порядка подмножеств
+string partitionStateKey(int index, const vector<int>& sums) {
+    vector<int> sorted = sums;
+    sort(sorted.begin(), sorted.end());
+    string key(reinterpret_cast<const char*>(&index), sizeof(index));
+    key.append(reinterpret_cast<const char*>(sorted.data()), sorted.size() * sizeof(int));
+    return key;
+}
+
+//подмножества с одинаковой суммой взаимозаменяемы: пробуем только первое из них
+bool isFirstWithSum(const vector<int>& sums, int bucket) {
+    for (int i = 0; i < bucket; i++) {
+        if (sums[i] == sums[bucket]) return false;
+    }
+    return true;
+}
+
+//перебор с запоминанием неудачных состояний и общим флагом отмены.
+//после первой проверенной ветви узла остальные ветви отдаются в очередь self,
+//если есть простаивающие потоки; такой узел исследован не до конца и не запоминается
+bool partitionSearch(const vector<int>& nums, int target, PartitionTask& task,
+                     FailedPartitionStates& failed, const atomic<bool>& found,
+                     PartitionQueues& work, int self) {
+    if (found.load(memory_order_relaxed)) return false;
+    if (task.index == static_cast<int>(nums.size())) return true;
+
+    //у самых глубоких узлов поиск дешевле, чем обращение к таблице
+    int remaining = static_cast<int>(nums.size()) - task.index;
+    bool memoize = remaining >= PARTITION_MEMO_MIN_REMAINING;
+    string key;
+    if (memoize) {
+        key = partitionStateKey(task.index, task.sums);
+        if (failed.contains(key)) return false;
+    }
+
+    int num = nums[task.index];
+    int smallest = nums.back();
+    int donatedBefore = task.donated;
+    bool donate = false;
+    for (int b = 0; b < static_cast<int>(task.sums.size()); b++) {
+        int gap = target - task.sums[b] - num;
+        if (gap < 0 || !isFirstWithSum(task.sums, b)) continue;
+        //остаток меньше наименьшего числа уже не заполнить
+        if (gap > 0 && gap < smallest) continue;
+
+        if (donate) {
+            PartitionTask child{task.index + 1, task.sums, task.owner, 0};
+            child.sums[b] += num;
+            child.owner[task.index] = b;
+            work.push(self, move(child));
+            task.donated++;
+            continue;
+        }
+
+        task.sums[b] += num;
+        task.owner[task.index++] = b;
+        if (partitionSearch(nums, target, task, failed, found, work, self)) return true;
+        task.index--;
+        task.sums[b] -= num;
+
+        //если число точно дополнило подмножество и это не помогло, другие варианты не помогут
+        if (gap == 0) break;
+        donate = remaining >= PARTITION_SPLIT_MIN_REMAINING && work.idle.load(memory_order_relaxed) > 0;
+    }
+
+    //при отмене или отданных ветвях состояние не исследовано до конца, запоминать его нельзя
+    if (memoize && task.donated == donatedBefore && !found.load(memory_order_relaxed)) failed.add(key);
+    return false;
+}
+
+//параллельное разбиение: верхние уровни дерева перебора раскрываются в задачи,
+//которые потоки берут из своих очередей и крадут из чужих; когда очереди пустеют,
+//занятые потоки делят свои задачи дальше (см. partitionSearch).
+//потоков не больше числа ядер: перебор упирается в процессор, лишние потоки только мешают
+bool partitionParallel(const vector<int>& nums, int target, int k, int threads,
+                       vector<vector<int>>& subsets) {
+    int n = nums.size();
+    int cores = max(1u, thread::hardware_concurrency());
+    if (threads <= 0 || threads > cores) threads = cores;
+
+    //раскрываем дерево в ширину, пока задач не станет достаточно для балансировки
+    vector<PartitionTask> tasks = {{0, vector<int>(k, 0), vector<int>(n, -1), 0}};
+    size_t wanted = static_cast<size_t>(threads) * 16;
+    while (tasks.size() < wanted && tasks.front().index < n / 2) {
+        vector<PartitionTask> next;
+        for (const PartitionTask& task : tasks) {
+            int num = nums[task.index];
+            for (int b = 0; b < k; b++) {
+                if (task.sums[b] + num > target || !isFirstWithSum(task.sums, b)) continue;
+                PartitionTask child = task;
+                child.sums[b] += num;
+                child.owner[child.index++] = b;
+                next.push_back(child);
+            }
+        }
+        if (next.empty()) return false;
+        tasks.swap(next);
+    }
+
+    //раздаем задачи по очередям потоков
+    PartitionQueues work(threads);
+    for (size_t i = 0; i < tasks.size(); i++) {
+        work.queues[i % threads].push_back(tasks[i]);
+    }
+
+    FailedPartitionStates failed;
+    atomic<bool> found(false);
+    mutex resultLock;
+    vector<int> solution;
+
+    //поток без задачи ждет, пока кто-то из занятых может отдать ему ветвь
+    auto worker = [&](int self) {
+        PartitionTask task;
+        bool waiting = false;
+        while (!found.load(memory_order_relaxed)) {
+            work.active++;
+            if (work.take(self, task)) {
+                if (waiting) {
+                    work.idle--;
+                    waiting = false;
+                }
+                if (partitionSearch(nums, target, task, failed, found, work, self)) {
+                    lock_guard<mutex> guard(resultLock);
+                    if (!found.exchange(true)) solution = task.owner;
+                }
+                work.active--;
+                continue;
+            }
+            //очереди пусты, и ветви отдавать некому - перебор окончен
+            if (--work.active == 0) break;
+            if (!waiting) {
+                work.idle++;
+                waiting = true;
+            }
+            this_thread::yield();
+        }
+        if (waiting) work.idle--;
+    };
+
+    vector<thread> pool;
+    for (int i = 1; i < threads; i++) {
+        pool.emplace_back(worker, i);
+    }
+    worker(0);
+    for (thread& t : pool) {
+        t.join();
+    }
+
+    if (!found) return false;
+
+    subsets.assign(k, vector<int>());
+    for (int i = 0; i < n; i++) {
+        subsets[solution[i]].push_back(nums[i]);
+    }
+    return true;
+}
+
 //основная функция разбиения множества на подмножества с заданной суммой
-bool partitionSetImproved(const Set* set, int subsetSum, vector<vector<int>>& result) {
+bool partitionSetImproved(const Set* set, int subsetSum, vector<vector<int>>& result,
+                          PartitionSolver solver, int threads) {
     vector<int> nums = setToVector(set);
     int totalSum = 0;
     for (int num : nums) {
@@ -362,11 +991,26 @@ bool partitionSetImproved(const Set* set, int subsetSum, vector<vector<int>>& re
         return false;
     }
     
+    //динамика по маскам применима к небольшим входам без отрицательных чисел
+    if (solver == PartitionSolver::Auto) {
+        bool dpFits = nums.size() <= PARTITION_DP_MAX_SIZE && nums.back() >= 0 && k > 0;
+        solver = dpFits ? PartitionSolver::BitmaskDP : PartitionSolver::Backtracking;
+    }
+
     //инициализируем подмножества
     vector<vector<int>> subsets(k);
     vector<int> subsetSums(k, 0);
     
-    if (partitionBacktrack(nums, subsets, subsetSums, subsetSum, 0)) {
+    bool found;
+    if (solver == PartitionSolver::BitmaskDP) {
+        found = partitionBitmaskDP(nums, subsetSum, k, subsets);
+    } else if (solver == PartitionSolver::Parallel) {
+        found = partitionParallel(nums, subsetSum, k, threads, subsets);
+    } else {
+        found = partitionBacktrack(nums, subsets, subsetSums, subsetSum, 0);
+    }
+
+    if (found) {
         result = subsets;
         return true;
     }
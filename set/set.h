@@ -3,16 +3,43 @@
 
 #include <vector>
 #include <string>
+#include <cstdint>
 
 struct NodeSet {
     int key;
     NodeSet* next;
 };
 
+//параметры вероятностных сводок
+const int HLL_PRECISION = 12;
+const int HLL_REGISTERS = 1 << HLL_PRECISION;
+const int MINHASH_SIZE = 256;
+
+//сводки множества: HyperLogLog для оценки мощности и bottom-k MinHash для оценки сходства
+struct SetSketch {
+    uint8_t registers[HLL_REGISTERS];
+    uint64_t minHashes[MINHASH_SIZE]; //наименьшие хэши элементов по возрастанию
+    int minHashCount;
+    bool stale; //после удаления сводку нужно перестроить
+};
+
+//размер блока упорядоченного индекса
+const int ORDERED_BLOCK_SIZE = 512;
+
+//упорядоченный индекс: отсортированные блоки не длиннее ORDERED_BLOCK_SIZE,
+//последний элемент каждого блока меньше первого элемента следующего.
+//counts - дерево Фенвика по размерам блоков: число элементов до блока за O(log n)
+struct OrderedIndex {
+    std::vector<std::vector<int>> blocks;
+    std::vector<int> counts;
+};
+
 struct Set {
     NodeSet** buckets;
     int tableSize;
     int itemCount;
+    SetSketch* sketch;
+    OrderedIndex* order; //nullptr, если упорядоченный индекс не включен
 };
 
 //базовые операции множества
@@ -31,14 +58,46 @@ Set intersection(const Set* set1, const Set* set2);
 Set difference(const Set* set1, const Set* set2);
 bool isSubset(const Set* set1, const Set* set2);
 
+//оценки по сводкам за O(размера сводки), без построения результата
+double estimateCardinality(const Set* set);
+double estimateUnionCardinality(const Set* set1, const Set* set2);
+double estimateJaccard(const Set* set1, const Set* set2);
+
+//упорядоченный индекс; отрезок [low, high] выдается за O(log n + k), ранг - за O(log n).
+//включение сортирует множество один раз; файл базы хранит индексированные множества
+//по возрастанию, и при загрузке индекс восстанавливается за O(n) без сортировки
+void enableOrderedIndex(Set* set);
+void enableOrderedIndexSorted(Set* set, const std::vector<int>& sortedKeys); //ключи - все элементы set по возрастанию
+void disableOrderedIndex(Set* set);
+std::vector<int> rangeQuery(const Set* set, int low, int high);
+bool minElement(const Set* set, int& result);
+bool maxElement(const Set* set, int& result);
+int rankOf(const Set* set, int key);
+std::vector<int> sortedElements(const Set* set);
+
 //вспомогательные функции
 void printSet(const Set* set);
 void saveSetToFile(const Set* set, const std::string& filename);
 void loadSetFromFile(Set* set, const std::string& filename);
 
+//способ поиска разбиения на подмножества
+enum class PartitionSolver {
+    Auto,         //выбор по размеру входа
+    Backtracking, //перебор с возвратом
+    BitmaskDP,    //динамика по битовым маскам O(n*2^n)
+    Parallel      //параллельный перебор с запоминанием неудачных состояний
+};
+
+//максимальное число элементов, для которого применяется динамика по маскам
+const int PARTITION_DP_MAX_SIZE = 28;
+
 //новые функции для работы с числами и разбиения на подмножества
 std::vector<int> setToVector(const Set* set);
 Set vectorToSet(const std::vector<int>& vec);
-bool partitionSetImproved(const Set* set, int subsetSum, std::vector<std::vector<int>>& result);
+bool partitionBitmaskDP(const std::vector<int>& nums, int target, int k, std::vector<std::vector<int>>& subsets);
+bool partitionParallel(const std::vector<int>& nums, int target, int k, int threads,
+                       std::vector<std::vector<int>>& subsets);
+bool partitionSetImproved(const Set* set, int subsetSum, std::vector<std::vector<int>>& result,
+                          PartitionSolver solver = PartitionSolver::Auto, int threads = 0);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,501 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <sstream>
+#include <cmath>
+#include "set.h"
+#include "hamtSet.h"
+#include "setStore.h"
+#include "setCodec.h"
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <map>
+
+using namespace std;
+using namespace std::chrono;
+
+//дополнение пробелами по числу символов, а не байтов (для кириллицы)
+string padRight(const string& text, int width) {
+    int letters = 0;
+    for (unsigned char c : text) {
+        if ((c & 0xC0) != 0x80) letters++;
+    }
+    return text + string(max(0, width - letters), ' ');
+}
+
+//генерация экземпляра 3-partition: все числа различны и лежат в (target/4, target/2),
+//поэтому каждое подмножество обязано содержать ровно три числа - худший случай для перебора
+vector<int> makeThreePartition(int k, int target, bool solvable, mt19937& gen) {
+    uniform_int_distribution<int> dist(target / 4 + 1, target / 2 - 1);
+
+    while (true) {
+        vector<int> nums;
+        long long sum = 0;
+
+        if (solvable) {
+            //собираем k троек с суммой target
+            for (int b = 0; b < k; b++) {
+                int x = dist(gen), y = dist(gen);
+                int z = target - x - y;
+                nums.insert(nums.end(), {x, y, z});
+            }
+        } else {
+            //случайные числа, последнее дополняет общую сумму до k * target
+            for (int i = 0; i < 3 * k - 1; i++) {
+                int x = dist(gen);
+                nums.push_back(x);
+                sum += x;
+            }
+            nums.push_back(static_cast<int>(static_cast<long long>(k) * target - sum));
+        }
+
+        vector<int> sorted = nums;
+        sort(sorted.begin(), sorted.end());
+        bool distinct = adjacent_find(sorted.begin(), sorted.end()) == sorted.end();
+        bool inRange = sorted.front() > target / 4 && sorted.back() < target / 2;
+        if (distinct && inRange) return nums;
+    }
+}
+
+//время одного запуска разбиения в секундах (вывод решателя подавляется)
+double measurePartition(const Set* set, int target, PartitionSolver solver, bool& found,
+                        int threads = 0) {
+    vector<vector<int>> result;
+    streambuf* saved = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+
+    auto start = high_resolution_clock::now();
+    found = partitionSetImproved(set, target, result, solver, threads);
+    auto end = high_resolution_clock::now();
+
+    cout.rdbuf(saved);
+    return duration_cast<microseconds>(end - start).count() / 1000000.0;
+}
+
+//сравнение перебора и динамики по маскам на экземплярах 3-partition
+void benchmarkPartition() {
+    const int target = 10007;
+    const int backtrackingLimit = 21; //дальше перебор работает слишком долго
+    mt19937 gen(42);
+
+    cout << "\nРАЗБИЕНИЕ: ПЕРЕБОР ПРОТИВ ДИНАМИКИ ПО МАСКАМ (3-partition, сумма " << target << ")\n";
+    cout << "┌──────┬────────────┬──────────┬──────────────┬──────────────┐\n";
+    cout << "│   n  │ экземпляр  │ разбиение│ перебор, с   │ маски, с     │\n";
+    cout << "├──────┼────────────┼──────────┼──────────────┼──────────────┤\n";
+
+    for (int k = 4; 3 * k <= PARTITION_DP_MAX_SIZE; k++) {
+        for (bool solvable : {true, false}) {
+            Set set = vectorToSet(makeThreePartition(k, target, solvable, gen));
+            int n = size(&set);
+
+            bool dpFound = false;
+            double dpTime = measurePartition(&set, target, PartitionSolver::BitmaskDP, dpFound);
+
+            string backtrackingCell;
+            if (n <= backtrackingLimit) {
+                bool btFound = false;
+                double btTime = measurePartition(&set, target, PartitionSolver::Backtracking, btFound);
+                ostringstream backtrackingTime;
+                backtrackingTime << fixed << setprecision(6) << setw(12) << btTime;
+                backtrackingCell = btFound == dpFound ? backtrackingTime.str() : padRight("РАСХОЖДЕНИЕ", 12);
+            } else {
+                backtrackingCell = padRight("пропущен", 12);
+            }
+
+            cout << "│ " << setw(4) << n << " │ "
+                 << padRight(solvable ? "решаемый" : "случайный", 10) << " │ "
+                 << padRight(dpFound ? "есть" : "нет", 8) << " │ "
+                 << backtrackingCell << " │ "
+                 << fixed << setprecision(6) << setw(12) << dpTime << " │\n";
+
+            destroySet(&set);
+        }
+    }
+
+    cout << "└──────┴────────────┴──────────┴──────────────┴──────────────┘\n";
+}
+
+//параллельный перебор с запоминанием на входах, недоступных динамике по маскам
+void benchmarkParallelPartition() {
+    const int target = 10007;
+    const int threadCounts[] = {1, 2, 4, 8};
+    mt19937 gen(7);
+
+    cout << "\nРАЗБИЕНИЕ: ПАРАЛЛЕЛЬНЫЙ ПЕРЕБОР (3-partition, сумма " << target << ")\n";
+    cout << "┌──────┬────────────┬──────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    cout << "│   n  │ экземпляр  │ разбиение│ 1 поток, с   │ 2 потока, с  │ 4 потока, с  │ 8 потоков, с │\n";
+    cout << "├──────┼────────────┼──────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+
+    for (int k = 7; k <= 9; k++) {
+        for (bool solvable : {true, false}) {
+            Set set = vectorToSet(makeThreePartition(k, target, solvable, gen));
+
+            bool found = false;
+            cout << "│ " << setw(4) << size(&set) << " │ "
+                 << padRight(solvable ? "решаемый" : "случайный", 10) << " │ ";
+
+            ostringstream times;
+            for (int threads : threadCounts) {
+                double time = measurePartition(&set, target, PartitionSolver::Parallel, found, threads);
+                times << " " << fixed << setprecision(6) << setw(12) << time << " │";
+            }
+            cout << padRight(found ? "есть" : "нет", 8) << " │" << times.str() << "\n";
+
+            destroySet(&set);
+        }
+    }
+
+    cout << "└──────┴────────────┴──────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n";
+}
+
+//оценки по сводкам против точного построения объединения и пересечения
+void benchmarkSketches() {
+    const int sizes[] = {10000, 100000, 1000000};
+    mt19937 gen(123);
+
+    cout << "\nСВОДКИ: ОЦЕНКА |A ∪ B| И ЖАККАРА ПРОТИВ ТОЧНОГО РАСЧЕТА (перекрытие 50%)\n";
+    cout << "┌─────────┬──────────────┬──────────────┬──────────┬──────────────┬──────────────┬──────────┐\n";
+    cout << "│    n    │ SUNION, с    │ оценка, с    │ ошибка % │ точн. J, с   │ оценка J, с  │ ошибка J │\n";
+    cout << "├─────────┼──────────────┼──────────────┼──────────┼──────────────┼──────────────┼──────────┤\n";
+
+    for (int n : sizes) {
+        Set a, b;
+        createSet(&a);
+        createSet(&b);
+        uniform_int_distribution<int> dist(0, 1 << 30);
+        while (size(&a) < n) {
+            int x = dist(gen);
+            insert(&a, x);
+            if (size(&a) % 2 == 0) insert(&b, x);
+        }
+        while (size(&b) < n) {
+            insert(&b, dist(gen));
+        }
+
+        auto start = high_resolution_clock::now();
+        Set united = unionSets(&a, &b);
+        int exactUnion = size(&united);
+        auto middle = high_resolution_clock::now();
+        Set common = intersection(&a, &b);
+        double exactJaccard = static_cast<double>(size(&common)) / exactUnion;
+        auto end = high_resolution_clock::now();
+        double exactUnionTime = duration_cast<microseconds>(middle - start).count() / 1000000.0;
+        double exactJaccardTime = duration_cast<microseconds>(end - start).count() / 1000000.0;
+
+        start = high_resolution_clock::now();
+        double estimatedUnion = estimateUnionCardinality(&a, &b);
+        middle = high_resolution_clock::now();
+        double estimatedJaccard = estimateJaccard(&a, &b);
+        end = high_resolution_clock::now();
+        double unionTime = duration_cast<nanoseconds>(middle - start).count() / 1e9;
+        double jaccardTime = duration_cast<nanoseconds>(end - middle).count() / 1e9;
+
+        double unionError = 100.0 * fabs(estimatedUnion - exactUnion) / exactUnion;
+        cout << "│ " << setw(7) << n << " │ "
+             << fixed << setprecision(6) << setw(12) << exactUnionTime << " │ "
+             << setw(12) << unionTime << " │ "
+             << setprecision(2) << setw(8) << unionError << " │ "
+             << setprecision(6) << setw(12) << exactJaccardTime << " │ "
+             << setw(12) << jaccardTime << " │ "
+             << setprecision(4) << setw(8) << fabs(estimatedJaccard - exactJaccard) << " │\n";
+
+        destroySet(&united);
+        destroySet(&common);
+        destroySet(&a);
+        destroySet(&b);
+    }
+
+    cout << "└─────────┴──────────────┴──────────────┴──────────┴──────────────┴──────────────┴──────────┘\n";
+}
+
+//приблизительная память хэш-множества: узлы цепочек с накладными расходами кучи и таблица
+size_t hashSetMemoryUsage(const Set* set) {
+    return set->itemCount * (sizeof(NodeSet) + 16) + set->tableSize * sizeof(NodeSet*);
+}
+
+//цепочка почти одинаковых версий: каждая следующая = предыдущая ∪ новые - старые
+void benchmarkPersistentVersions() {
+    const int baseSize = 200000;
+    const int versionCount = 20;
+    const int changesPerVersion = 100;
+    mt19937 gen(99);
+    uniform_int_distribution<int> dist(0, 1 << 30);
+
+    vector<int> baseKeys;
+    for (int i = 0; i < baseSize; i++) {
+        baseKeys.push_back(dist(gen));
+    }
+
+    cout << "\nВЕРСИИ МНОЖЕСТВА: " << versionCount << " производных от " << baseSize
+         << " элементов, по " << changesPerVersion << " добавлений и удалений\n";
+    cout << "┌──────────────────┬──────────────┬──────────────┐\n";
+    cout << "│ представление    │ время, с     │ память, МБ   │\n";
+    cout << "├──────────────────┼──────────────┼──────────────┤\n";
+
+    //хэш-множества: каждая версия - полная копия
+    auto start = high_resolution_clock::now();
+    vector<Set> hashVersions = {vectorToSet(baseKeys)};
+    for (int v = 0; v < versionCount; v++) {
+        vector<int> added, removed;
+        for (int i = 0; i < changesPerVersion; i++) {
+            added.push_back(dist(gen));
+            removed.push_back(baseKeys[gen() % baseSize]);
+        }
+        Set addedSet = vectorToSet(added), removedSet = vectorToSet(removed);
+        Set grown = unionSets(&hashVersions.back(), &addedSet);
+        hashVersions.push_back(difference(&grown, &removedSet));
+        destroySet(&grown);
+        destroySet(&addedSet);
+        destroySet(&removedSet);
+    }
+    double hashTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+    size_t hashBytes = 0;
+    for (Set& version : hashVersions) {
+        hashBytes += hashSetMemoryUsage(&version);
+        destroySet(&version);
+    }
+
+    //персистентные множества: версии разделяют неизмененные поддеревья
+    gen.seed(99);
+    start = high_resolution_clock::now();
+    PersistentSet base;
+    createSet(&base);
+    for (int key : baseKeys) {
+        insert(&base, key);
+    }
+    vector<PersistentSet> versions = {base};
+    for (int v = 0; v < versionCount; v++) {
+        PersistentSet added, removed;
+        createSet(&added);
+        createSet(&removed);
+        for (int i = 0; i < changesPerVersion; i++) {
+            insert(&added, dist(gen));
+            insert(&removed, baseKeys[gen() % baseSize]);
+        }
+        PersistentSet grown = unionSets(&versions.back(), &added);
+        versions.push_back(difference(&grown, &removed));
+    }
+    double persistentTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+    size_t persistentBytes = sharedMemoryUsage(versions);
+
+    cout << "│ хэш-таблица      │ " << fixed << setprecision(6) << setw(12) << hashTime << " │ "
+         << setprecision(2) << setw(12) << hashBytes / 1048576.0 << " │\n";
+    cout << "│ HAMT             │ " << setprecision(6) << setw(12) << persistentTime << " │ "
+         << setprecision(2) << setw(12) << persistentBytes / 1048576.0 << " │\n";
+    cout << "└──────────────────┴──────────────┴──────────────┘\n";
+}
+
+//одна операция смешанной нагрузки: чтения, изменения и изредка бинарные операции
+void mixedOperation(SetStore& store, int setCount, mt19937& gen) {
+    int op = gen() % 100;
+    string name = "s" + to_string(gen() % setCount);
+    int key = gen() % 100000;
+
+    if (op < 80) {
+        NamedSetPtr entry = store.find(name);
+        shared_lock<shared_mutex> guard(entry->lock);
+        if (op < 50) {
+            contains(&entry->set, key);
+        } else if (op < 75) {
+            size(&entry->set);
+        } else {
+            setToVector(&entry->set);
+        }
+    } else if (op < 98) {
+        NamedSetPtr entry = store.find(name);
+        unique_lock<shared_mutex> guard(entry->lock);
+        if (op % 2 == 0) {
+            insert(&entry->set, key);
+        } else {
+            remove(&entry->set, key);
+        }
+    } else {
+        NamedSetPtr first = store.find(name);
+        NamedSetPtr second = store.find("s" + to_string(gen() % setCount));
+        auto guards = lockShared({first, second});
+        Set result = unionSets(&first->set, &second->set);
+        destroySet(&result);
+    }
+}
+
+//та же нагрузка на обычной map под одним общим мьютексом
+void mixedOperationGlobalLock(map<string, Set*>& store, mutex& lock, int setCount, mt19937& gen) {
+    int op = gen() % 100;
+    string name = "s" + to_string(gen() % setCount);
+    int key = gen() % 100000;
+
+    lock_guard<mutex> guard(lock);
+    Set* set = store[name];
+    if (op < 50) {
+        contains(set, key);
+    } else if (op < 75) {
+        size(set);
+    } else if (op < 80) {
+        setToVector(set);
+    } else if (op < 98) {
+        if (op % 2 == 0) {
+            insert(set, key);
+        } else {
+            remove(set, key);
+        }
+    } else {
+        Set result = unionSets(set, store["s" + to_string(gen() % setCount)]);
+        destroySet(&result);
+    }
+}
+
+//многопоточная смешанная нагрузка: 80% чтений, 18% изменений, 2% объединений
+void benchmarkConcurrentStore() {
+    const int setCount = 64;
+    const int setSize = 2000;
+    const int opsPerThread = 50000;
+    const int threadCounts[] = {1, 2, 4, 8};
+
+    SetStore store;
+    map<string, Set*> plain;
+    mt19937 gen(5);
+    for (int i = 0; i < setCount; i++) {
+        Set set, copy;
+        createSet(&set);
+        createSet(&copy);
+        for (int j = 0; j < setSize; j++) {
+            int key = gen() % 100000;
+            insert(&set, key);
+            insert(&copy, key);
+        }
+        store.put("s" + to_string(i), set);
+        plain["s" + to_string(i)] = new Set(copy);
+    }
+    mutex globalLock;
+
+    cout << "\nХРАНИЛИЩЕ МНОЖЕСТВ: СМЕШАННАЯ НАГРУЗКА (" << setCount << " множеств, "
+         << opsPerThread << " операций на поток)\n";
+    cout << "┌─────────┬──────────────────┬──────────────────┐\n";
+    cout << "│ потоки  │ общий мьютекс,   │ блокировки по    │\n";
+    cout << "│         │ опер./с          │ множествам, оп/с │\n";
+    cout << "├─────────┼──────────────────┼──────────────────┤\n";
+
+    for (int threads : threadCounts) {
+        double rates[2];
+        for (int mode = 0; mode < 2; mode++) {
+            vector<thread> pool;
+            auto start = high_resolution_clock::now();
+            for (int t = 0; t < threads; t++) {
+                pool.emplace_back([&, t]() {
+                    mt19937 local(1000 + t);
+                    for (int i = 0; i < opsPerThread; i++) {
+                        if (mode == 0) {
+                            mixedOperationGlobalLock(plain, globalLock, setCount, local);
+                        } else {
+                            mixedOperation(store, setCount, local);
+                        }
+                    }
+                });
+            }
+            for (thread& worker : pool) {
+                worker.join();
+            }
+            double seconds = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+            rates[mode] = static_cast<double>(threads) * opsPerThread / seconds;
+        }
+
+        cout << "│ " << setw(7) << threads << " │ "
+             << fixed << setprecision(0) << setw(16) << rates[0] << " │ "
+             << setw(16) << rates[1] << " │\n";
+    }
+
+    cout << "└─────────┴──────────────────┴──────────────────┘\n";
+
+    for (auto& pair : plain) {
+        destroySet(pair.second);
+        delete pair.second;
+    }
+}
+
+//текстовый формат против двоичного: размер, загрузка и поиск по отрезку
+void benchmarkCodec() {
+    const int sizes[] = {100000, 1000000};
+    mt19937 gen(17);
+
+    cout << "\nДВОИЧНЫЙ ФОРМАТ: РАЗНОСТИ + STREAM-VBYTE ПРОТИВ ТЕКСТА\n";
+    cout << "┌─────────┬────────────┬────────────┬──────────────┬──────────────┬──────────────┬──────────────┐\n";
+    cout << "│    n    │ текст, КБ  │ двоич., КБ │ разбор, с    │ декод., с    │ отрезок, с   │ скан табл., с│\n";
+    cout << "├─────────┼────────────┼────────────┼──────────────┼──────────────┼──────────────┼──────────────┤\n";
+
+    for (int n : sizes) {
+        Set set;
+        createSet(&set);
+        uniform_int_distribution<int> dist(0, 50 * n);
+        while (size(&set) < n) {
+            insert(&set, dist(gen));
+        }
+
+        //текст в формате saveToFile
+        ostringstream text;
+        for (int key : setToVector(&set)) {
+            text << key << " ";
+        }
+        string textData = text.str();
+
+        vector<uint8_t> binary;
+        encodeSet(&set, binary);
+
+        auto start = high_resolution_clock::now();
+        Set fromText;
+        createSet(&fromText);
+        istringstream input(textData);
+        string token;
+        while (input >> token) {
+            insert(&fromText, stoi(token));
+        }
+        double textTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        start = high_resolution_clock::now();
+        const uint8_t* data = binary.data();
+        Set fromBinary = decodeSet(data, binary.data() + binary.size());
+        double binaryTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        //отрезок шириной в 1% диапазона значений
+        int low = 25 * n, high = low + n / 2;
+        start = high_resolution_clock::now();
+        vector<int> range = rangeScanEncoded(binary.data(), binary.data() + binary.size(), low, high);
+        double rangeTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        start = high_resolution_clock::now();
+        vector<int> scanned;
+        for (int key : setToVector(&set)) {
+            if (key >= low && key <= high) scanned.push_back(key);
+        }
+        double scanTime = duration_cast<microseconds>(high_resolution_clock::now() - start).count() / 1e6;
+
+        cout << "│ " << setw(7) << n << " │ "
+             << setw(10) << textData.size() / 1024 << " │ "
+             << setw(10) << binary.size() / 1024 << " │ "
+             << fixed << setprecision(6) << setw(12) << textTime << " │ "
+             << setw(12) << binaryTime << " │ "
+             << setw(12) << rangeTime << " │ "
+             << setw(12) << scanTime << " │\n";
+
+        destroySet(&set);
+        destroySet(&fromText);
+        destroySet(&fromBinary);
+    }
+
+    cout << "└─────────┴────────────┴────────────┴──────────────┴──────────────┴──────────────┴──────────────┘\n";
+}
+
+int main() {
+    benchmarkPartition();
+    benchmarkParallelPartition();
+    benchmarkSketches();
+    benchmarkPersistentVersions();
+    benchmarkConcurrentStore();
+    benchmarkCodec();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,266 @@
+#include "setCodec.h"
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
+
+using namespace std;
+
+//заголовок блока: границы значений, число элементов и длина закодированных данных
+struct CodecBlockHeader {
+    int32_t min;
+    int32_t max;
+    uint32_t count;
+    uint32_t length;
+};
+
+//знаковое число в беззнаковое с сохранением порядка
+uint32_t orderedBits(int key) {
+    return static_cast<uint32_t>(key) ^ 0x80000000U;
+}
+
+int fromOrderedBits(uint32_t bits) {
+    return static_cast<int>(bits ^ 0x80000000U);
+}
+
+template<typename T>
+void appendRaw(vector<uint8_t>& out, const T& value) {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+template<typename T>
+T readRaw(const uint8_t*& data, const uint8_t* end) {
+    if (end - data < static_cast<ptrdiff_t>(sizeof(T))) {
+        throw runtime_error("Двоичные данные множества обрезаны");
+    }
+    T value;
+    memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+}
+
+//число байт, нужное для записи значения (1-4)
+int varintLength(uint32_t value) {
+    if (value < (1U << 8)) return 1;
+    if (value < (1U << 16)) return 2;
+    if (value < (1U << 24)) return 3;
+    return 4;
+}
+
+//кодирование одного блока отсортированных значений
+void encodeBlock(const uint32_t* values, uint32_t count, vector<uint8_t>& out) {
+    CodecBlockHeader header{fromOrderedBits(values[0]), fromOrderedBits(values[count - 1]), count, 0};
+    size_t headerPos = out.size();
+    appendRaw(out, header);
+
+    size_t controlPos = out.size();
+    out.resize(out.size() + (count + 3) / 4, 0);
+
+    uint32_t previous = values[0];
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t delta = values[i] - previous;
+        previous = values[i];
+        int length = varintLength(delta);
+        out[controlPos + i / 4] |= (length - 1) << (2 * (i % 4));
+        for (int b = 0; b < length; b++) {
+            out.push_back(static_cast<uint8_t>(delta >> (8 * b)));
+        }
+    }
+
+    header.length = out.size() - controlPos;
+    memcpy(&out[headerPos], &header, sizeof(header));
+}
+
+#ifdef __SSSE3__
+//таблицы для pshufb: по управляющему байту - перестановка 16 байт в 4 числа и их общая длина
+struct StreamVByteTables {
+    uint8_t shuffle[256][16];
+    uint8_t length[256];
+
+    StreamVByteTables() {
+        for (int control = 0; control < 256; control++) {
+            int source = 0;
+            for (int i = 0; i < 4; i++) {
+                int bytes = ((control >> (2 * i)) & 3) + 1;
+                for (int b = 0; b < 4; b++) {
+                    shuffle[control][4 * i + b] = (b < bytes) ? source + b : 0x80;
+                }
+                source += bytes;
+            }
+            length[control] = source;
+        }
+    }
+};
+
+const StreamVByteTables& streamVByteTables() {
+    static const StreamVByteTables tables;
+    return tables;
+}
+#endif
+
+//декодирование разностей блока в deltas
+void decodeDeltas(const uint8_t* control, const uint8_t* data, const uint8_t* dataEnd,
+                  uint32_t count, uint32_t* deltas) {
+    uint32_t i = 0;
+#ifdef __SSSE3__
+    //по 4 числа за раз, пока можно безопасно прочитать 16 байт
+    const StreamVByteTables& tables = streamVByteTables();
+    for (; i + 4 <= count && dataEnd - data >= 16; i += 4) {
+        uint8_t code = control[i / 4];
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables.shuffle[code]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(deltas + i), _mm_shuffle_epi8(bytes, mask));
+        data += tables.length[code];
+    }
+#endif
+    for (; i < count; i++) {
+        int length = ((control[i / 4] >> (2 * (i % 4))) & 3) + 1;
+        if (dataEnd - data < length) {
+            throw runtime_error("Двоичные данные множества повреждены");
+        }
+        uint32_t value = 0;
+        for (int b = 0; b < length; b++) {
+            value |= static_cast<uint32_t>(data[b]) << (8 * b);
+        }
+        deltas[i] = value;
+        data += length;
+    }
+}
+
+//декодирование блока: вызывает emit для каждого элемента по возрастанию
+template<typename Emit>
+void decodeBlock(const CodecBlockHeader& header, const uint8_t* payload, Emit emit) {
+    uint32_t deltas[CODEC_BLOCK_SIZE];
+    const uint8_t* control = payload;
+    const uint8_t* data = payload + (header.count + 3) / 4;
+    decodeDeltas(control, data, payload + header.length, header.count, deltas);
+
+    uint32_t value = orderedBits(header.min);
+    for (uint32_t i = 0; i < header.count; i++) {
+        value += deltas[i];
+        emit(fromOrderedBits(value));
+    }
+}
+
+//чтение заголовка блока с проверкой границ
+CodecBlockHeader readBlockHeader(const uint8_t*& data, const uint8_t* end) {
+    CodecBlockHeader header = readRaw<CodecBlockHeader>(data, end);
+    if (header.count == 0 || header.count > CODEC_BLOCK_SIZE ||
+        header.length < (header.count + 3) / 4 || static_cast<size_t>(end - data) < header.length) {
+        throw runtime_error("Двоичные данные множества повреждены");
+    }
+    return header;
+}
+
+//кодирование множества: число элементов, число блоков, блоки
+void encodeSet(const Set* set, vector<uint8_t>& out) {
+    vector<uint32_t> values;
+    values.reserve(set->itemCount);
+    for (int key : setToVector(set)) {
+        values.push_back(orderedBits(key));
+    }
+    //при упорядоченном индексе элементы уже идут по возрастанию, orderedBits порядок сохраняет
+    if (!set->order) {
+        sort(values.begin(), values.end());
+    }
+
+    uint32_t blockCount = (values.size() + CODEC_BLOCK_SIZE - 1) / CODEC_BLOCK_SIZE;
+    appendRaw(out, static_cast<uint32_t>(values.size()));
+    appendRaw(out, blockCount);
+    for (size_t i = 0; i < values.size(); i += CODEC_BLOCK_SIZE) {
+        uint32_t count = min<size_t>(CODEC_BLOCK_SIZE, values.size() - i);
+        encodeBlock(values.data() + i, count, out);
+    }
+}
+
+//декодирование множества в таблицу, размер которой известен заранее
+Set decodeSet(const uint8_t*& data, const uint8_t* end, bool ordered) {
+    uint32_t count = readRaw<uint32_t>(data, end);
+    uint32_t blockCount = readRaw<uint32_t>(data, end);
+    //каждый элемент занимает хотя бы байт - иначе заголовок поврежден
+    if (count > static_cast<size_t>(end - data) ||
+        blockCount != (count + CODEC_BLOCK_SIZE - 1) / CODEC_BLOCK_SIZE) {
+        throw runtime_error("Двоичные данные множества повреждены");
+    }
+
+    //таблица сразу достаточного размера: рехеширование при загрузке не понадобится
+    Set set;
+    createSet(&set, max<long long>(101, static_cast<long long>(count) * 10 / 7 + 1));
+    vector<int> sortedKeys;
+    try {
+        for (uint32_t b = 0; b < blockCount; b++) {
+            CodecBlockHeader header = readBlockHeader(data, end);
+            decodeBlock(header, data, [&](int key) {
+                if (insert(&set, key) && ordered) sortedKeys.push_back(key);
+            });
+            data += header.length;
+        }
+        if (ordered) {
+            //поврежденные разности могут нарушить порядок - тогда индекс строится сортировкой
+            if (is_sorted(sortedKeys.begin(), sortedKeys.end())) {
+                enableOrderedIndexSorted(&set, sortedKeys);
+            } else {
+                enableOrderedIndex(&set);
+            }
+        }
+    } catch (...) {
+        destroySet(&set);
+        throw;
+    }
+    return set;
+}
+
+//поиск по отрезку: блоки, чьи [min, max] не пересекают [low, high], пропускаются целиком
+vector<int> rangeScanEncoded(const uint8_t* data, const uint8_t* end, int low, int high) {
+    vector<int> result;
+    readRaw<uint32_t>(data, end);
+    uint32_t blockCount = readRaw<uint32_t>(data, end);
+
+    for (uint32_t b = 0; b < blockCount; b++) {
+        CodecBlockHeader header = readBlockHeader(data, end);
+        if (header.min > high) break; //блоки упорядочены
+        if (header.max >= low) {
+            decodeBlock(header, data, [&](int key) {
+                if (key >= low && key <= high) result.push_back(key);
+            });
+        }
+        data += header.length;
+    }
+    return result;
+}
+
+//сохранение множества в двоичный файл
+void saveSetBinary(const Set* set, const string& filename) {
+    ofstream file(filename, ios::binary);
+    if (!file) {
+        cerr << "Ошибка открытия файла для записи: " << filename << endl;
+        return;
+    }
+
+    vector<uint8_t> bytes;
+    encodeSet(set, bytes);
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    file.close();
+}
+
+//загрузка множества из двоичного файла (элементы добавляются к set)
+void loadSetBinary(Set* set, const string& filename) {
+    ifstream file(filename, ios::binary);
+    if (!file) {
+        cerr << "Ошибка открытия файла для чтения: " << filename << endl;
+        return;
+    }
+
+    vector<uint8_t> bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    const uint8_t* data = bytes.data();
+    Set loaded = decodeSet(data, data + bytes.size());
+    for (int key : setToVector(&loaded)) {
+        insert(set, key);
+    }
+    destroySet(&loaded);
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef SET_CODEC_H
+#define SET_CODEC_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "set.h"
+
+//двоичное представление множества: элементы отсортированы, разбиты на блоки
+//по CODEC_BLOCK_SIZE, в каждом блоке заголовок (min, max, число, длина) и разности
+//соседних элементов в формате stream-vbyte: 2 бита длины на число в управляющих байтах,
+//затем 1-4 байта самого числа; такой формат декодируется по 4 числа одной инструкцией pshufb
+const int CODEC_BLOCK_SIZE = 256;
+
+//кодирование дописывает байты в конец out
+void encodeSet(const Set* set, std::vector<uint8_t>& out);
+//декодирование в заранее выделенную таблицу нужного размера; data сдвигается за множество.
+//ordered - сразу включить упорядоченный индекс: элементы приходят по возрастанию, сортировка не нужна
+Set decodeSet(const uint8_t*& data, const uint8_t* end, bool ordered = false);
+//элементы из [low, high] без декодирования блоков, которые не пересекают отрезок
+std::vector<int> rangeScanEncoded(const uint8_t* data, const uint8_t* end, int low, int high);
+
+//сохранение и загрузка одного множества в двоичном виде
+void saveSetBinary(const Set* set, const std::string& filename);
+void loadSetBinary(Set* set, const std::string& filename);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,257 @@
+#include "setExpression.h"
+#include <vector>
+#include <string>
+#include <cctype>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+//узел выражения; одинаковые операции подряд сливаются в один n-арный узел
+struct SetExprNode {
+    char op;                      //0 - имя множества, иначе '|', '&' или '-'
+    const Set* set;               //для листа
+    vector<SetExprNode> children; //для разности первый потомок - уменьшаемое
+    long long estimate;           //верхняя оценка мощности результата
+};
+
+class SetExpressionEvaluator {
+private:
+    const map<string, Set*>& sets;
+    vector<string> tokens;
+    size_t pos;
+
+    //разбиение строки на имена, операции и скобки
+    void tokenize(const string& expression) {
+        for (size_t i = 0; i < expression.length(); i++) {
+            char c = expression[i];
+            if (c == ' ') continue;
+
+            if (c == '|' || c == '&' || c == '-' || c == '(' || c == ')') {
+                tokens.push_back(string(1, c));
+            } else if (isalnum(static_cast<unsigned char>(c)) || c == '_') {
+                string name;
+                while (i < expression.length() &&
+                       (isalnum(static_cast<unsigned char>(expression[i])) || expression[i] == '_')) {
+                    name += expression[i++];
+                }
+                i--; //возвращаемся на один символ назад
+                tokens.push_back(name);
+            } else {
+                throw runtime_error(string("Недопустимый символ в выражении: ") + c);
+            }
+        }
+    }
+
+    bool peek(const string& token) const {
+        return pos < tokens.size() && tokens[pos] == token;
+    }
+
+    //присоединение операнда к n-арному узлу с той же операцией
+    void append(SetExprNode& node, SetExprNode operand) {
+        if (operand.op == node.op && node.op != '-') {
+            for (SetExprNode& child : operand.children) {
+                node.children.push_back(move(child));
+            }
+        } else {
+            node.children.push_back(move(operand));
+        }
+    }
+
+    //разбор уровня с операцией op над операндами, которые разбирает parseOperand
+    SetExprNode parseLevel(char op, SetExprNode (SetExpressionEvaluator::*parseOperand)()) {
+        SetExprNode first = (this->*parseOperand)();
+        if (!peek(string(1, op))) return first;
+
+        SetExprNode node{op, nullptr, {}, 0};
+        append(node, move(first));
+        while (peek(string(1, op))) {
+            pos++;
+            //a - b - c = a - (b | c): все вычитаемые становятся потомками одного узла
+            append(node, (this->*parseOperand)());
+        }
+        return node;
+    }
+
+    SetExprNode parseUnion() {
+        return parseLevel('|', &SetExpressionEvaluator::parseIntersection);
+    }
+
+    SetExprNode parseIntersection() {
+        return parseLevel('&', &SetExpressionEvaluator::parseDifference);
+    }
+
+    SetExprNode parseDifference() {
+        return parseLevel('-', &SetExpressionEvaluator::parsePrimary);
+    }
+
+    SetExprNode parsePrimary() {
+        if (pos >= tokens.size()) {
+            throw runtime_error("Неожиданный конец выражения");
+        }
+
+        if (peek("(")) {
+            pos++;
+            SetExprNode node = parseUnion();
+            if (!peek(")")) {
+                throw runtime_error("Ожидалась закрывающая скобка");
+            }
+            pos++;
+            return node;
+        }
+
+        const string& name = tokens[pos];
+        if (name.length() == 1 && string("|&-)").find(name[0]) != string::npos) {
+            throw runtime_error("Ожидалось имя множества вместо '" + name + "'");
+        }
+        auto it = sets.find(name);
+        if (it == sets.end()) {
+            throw runtime_error("Множество '" + name + "' не найдено");
+        }
+        pos++;
+        return SetExprNode{0, it->second, {}, 0};
+    }
+
+    //оценка мощностей и упорядочивание операндов: пересечения начинаются с наименьшего
+    void plan(SetExprNode& node) {
+        if (node.op == 0) {
+            node.estimate = size(node.set);
+            return;
+        }
+
+        for (SetExprNode& child : node.children) {
+            plan(child);
+        }
+
+        auto bySize = [](const SetExprNode& a, const SetExprNode& b) { return a.estimate < b.estimate; };
+        if (node.op == '&') {
+            sort(node.children.begin(), node.children.end(), bySize);
+            node.estimate = node.children.front().estimate;
+        } else if (node.op == '|') {
+            //сначала большие операнды: меньше элементов придется проверять на повтор
+            sort(node.children.rbegin(), node.children.rend(), bySize);
+            node.estimate = 0;
+            for (const SetExprNode& child : node.children) {
+                node.estimate += child.estimate;
+            }
+        } else {
+            //вычитаемые проверяем начиная с наибольшего - он чаще отсекает элемент
+            sort(node.children.begin() + 1, node.children.end(),
+                 [&](const SetExprNode& a, const SetExprNode& b) { return bySize(b, a); });
+            node.estimate = node.children.front().estimate;
+        }
+    }
+
+    //проверка принадлежности ключа результату узла
+    bool member(const SetExprNode& node, int key) const {
+        switch (node.op) {
+        case 0:
+            return contains(node.set, key);
+        case '|':
+            for (const SetExprNode& child : node.children) {
+                if (member(child, key)) return true;
+            }
+            return false;
+        case '&':
+            for (const SetExprNode& child : node.children) {
+                if (!member(child, key)) return false;
+            }
+            return true;
+        default:
+            if (!member(node.children.front(), key)) return false;
+            for (size_t i = 1; i < node.children.size(); i++) {
+                if (member(node.children[i], key)) return false;
+            }
+            return true;
+        }
+    }
+
+    //потоковый перебор элементов результата узла, каждый элемент выдается один раз
+    void generate(const SetExprNode& node, const function<void(int)>& emit) const {
+        switch (node.op) {
+        case 0:
+            for (int i = 0; i < node.set->tableSize; i++) {
+                for (NodeSet* current = node.set->buckets[i]; current != nullptr; current = current->next) {
+                    emit(current->key);
+                }
+            }
+            return;
+        case '|':
+            //элемент i-го операнда выдаем, только если его нет в предыдущих
+            for (size_t i = 0; i < node.children.size(); i++) {
+                generate(node.children[i], [&](int key) {
+                    for (size_t j = 0; j < i; j++) {
+                        if (member(node.children[j], key)) return;
+                    }
+                    emit(key);
+                });
+            }
+            return;
+        case '&':
+            //кандидаты берем из наименьшего операнда и проверяем в остальных
+            generate(node.children.front(), [&](int key) {
+                for (size_t i = 1; i < node.children.size(); i++) {
+                    if (!member(node.children[i], key)) return;
+                }
+                emit(key);
+            });
+            return;
+        default:
+            generate(node.children.front(), [&](int key) {
+                for (size_t i = 1; i < node.children.size(); i++) {
+                    if (member(node.children[i], key)) return;
+                }
+                emit(key);
+            });
+            return;
+        }
+    }
+
+public:
+    SetExpressionEvaluator(const map<string, Set*>& namedSets) : sets(namedSets), pos(0) {}
+
+    vector<string> names(const string& expression) {
+        tokenize(expression);
+        vector<string> result;
+        for (const string& token : tokens) {
+            if (token.length() == 1 && string("|&-()").find(token[0]) != string::npos) continue;
+            if (find(result.begin(), result.end(), token) == result.end()) {
+                result.push_back(token);
+            }
+        }
+        return result;
+    }
+
+    Set evaluate(const string& expression) {
+        tokenize(expression);
+        if (tokens.empty()) {
+            throw runtime_error("Пустое выражение");
+        }
+
+        SetExprNode root = parseUnion();
+        if (pos != tokens.size()) {
+            throw runtime_error("Лишний токен в выражении: " + tokens[pos]);
+        }
+        plan(root);
+
+        //единственное строящееся множество - итоговое
+        Set result;
+        createSet(&result, static_cast<int>(max(101LL, min(root.estimate, 1LL << 24) * 10 / 7 + 1)));
+        generate(root, [&](int key) { insert(&result, key); });
+        return result;
+    }
+};
+
+//вычисление выражения над именованными множествами
+Set evaluateSetExpression(const string& expression, const map<string, Set*>& sets) {
+    SetExpressionEvaluator evaluator(sets);
+    return evaluator.evaluate(expression);
+}
+
+//имена множеств, упомянутых в выражении
+vector<string> expressionSetNames(const string& expression) {
+    map<string, Set*> none;
+    SetExpressionEvaluator evaluator(none);
+    return evaluator.names(expression);
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef SET_EXPRESSION_H
+#define SET_EXPRESSION_H
+
+#include <map>
+#include <string>
+#include <vector>
+#include "set.h"
+
+//вычисление выражения над именованными множествами без промежуточных множеств.
+//операции: | - объединение, & - пересечение, - - разность, скобки для группировки;
+//приоритет от высшего к низшему: -, &, |
+Set evaluateSetExpression(const std::string& expression, const std::map<std::string, Set*>& sets);
+
+//имена множеств, упомянутых в выражении (нужны, чтобы заранее заблокировать операнды)
+std::vector<std::string> expressionSetNames(const std::string& expression);
+
+#endif
\ No newline at end of file
@@ -5,25 +5,40 @@
 #include <map>
 #include <vector>
 #include <cstring>
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+#include <mutex>
+#include <shared_mutex>
 #include "set.h"
+#include "setExpression.h"
+#include "setStore.h"
+#include "setCodec.h"
 
 using namespace std;
 
-//база данных - теперь только множества
-map<string, Set*> sets;
+//база данных - теперь только множества; доступ к ней потокобезопасен
+SetStore sets;
 
-//функции для работы с файлом
+//функции для работы с файлом (файлы *.bin хранятся в двоичном формате)
 void saveToFile(const string& filename);
 void loadFromFile(const string& filename);
+void saveToBinaryFile(const string& filename);
+void loadFromBinaryFile(const string& filename);
+bool isBinaryFile(const string& filename);
 
 //функции для обработки команд множества
 void processSetQuery(const vector<string>& tokens);
 void processSetOperation(const vector<string>& tokens);
+void processExpressionOperation(const vector<string>& tokens);
 void processPartitionOperation(const vector<string>& tokens);
+void processSketchQuery(const vector<string>& tokens);
+void processOrderedQuery(const vector<string>& tokens);
 
 //вспомогательные функции
 vector<string> split(const string& str, char delimiter);
 int stringToInt(const string& str);
+void storeResult(const string& name, const Set& result);
 
 int main(int argc, char* argv[]) {
     string filename;
@@ -60,6 +75,9 @@ int main(int argc, char* argv[]) {
         if (command == "SINSERT" || command == "SCONTAINS" || command == "SREMOVE" || 
             command == "SSIZE" || command == "SCLEAR") {
             processSetQuery(tokens);
+        } else if (command == "SEVAL" || command == "SINTER" ||
+                   (command == "SUNION" && tokens.size() > 4)) {
+            processExpressionOperation(tokens);
         } else if (command == "SUNION" || command == "SINTERSECTION" || 
                    command == "SDIFFERENCE" || command == "SSUBSET") {
             processSetOperation(tokens);
@@ -69,14 +87,20 @@ int main(int argc, char* argv[]) {
                 return 1;
             }
             string setName = tokens[1];
-            if (sets.find(setName) != sets.end()) {
+            NamedSetPtr entry = sets.find(setName);
+            if (entry) {
+                shared_lock<shared_mutex> guard(entry->lock);
                 cout << "Множество '" << setName << "': ";
-                printSet(sets[setName]);
+                printSet(&entry->set);
             } else {
                 cout << "Множество '" << setName << "' не найдено" << endl;
             }
         } else if (command == "SPARTITION") {
             processPartitionOperation(tokens);
+        } else if (command == "SCARDEST" || command == "SUNIONCARD" || command == "SJACCARD") {
+            processSketchQuery(tokens);
+        } else if (command == "SRANGE" || command == "SMIN" || command == "SMAX" || command == "SRANK") {
+            processOrderedQuery(tokens);
         } else {
             cout << "Неизвестная команда: " << command << endl;
             return 1;
@@ -86,15 +110,9 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    //сохранение данных в файл
+    //сохранение данных в файл (память множеств освобождает хранилище)
     saveToFile(filename);
 
-    //очистка памяти
-    for (auto& pair : sets) {
-        destroySet(pair.second);
-        delete pair.second;
-    }
-
     return 0;
 }
 
@@ -131,13 +149,19 @@ void processSetQuery(const vector<string>& tokens) {
     string setName = tokens[1];
 
     //создаем множество, если не существует
-    if (sets.find(setName) == sets.end()) {
-        sets[setName] = new Set();
-        createSet(sets[setName]);
+    NamedSetPtr entry = sets.findOrCreate(setName);
+    Set* set = &entry->set;
+
+    //чтение выполняется параллельно с другими читателями, изменение - монопольно
+    bool reading = (command == "SCONTAINS" || command == "SSIZE" || command == "SEMPTY");
+    shared_lock<shared_mutex> readGuard(entry->lock, defer_lock);
+    unique_lock<shared_mutex> writeGuard(entry->lock, defer_lock);
+    if (reading) {
+        readGuard.lock();
+    } else {
+        writeGuard.lock();
     }
 
-    Set* set = sets[setName];
-
     if (command == "SINSERT") {
         if (tokens.size() < 3) {
             cout << "SINSERT требует значение" << endl;
@@ -183,7 +207,8 @@ void processSetQuery(const vector<string>& tokens) {
     }
 }
 
-//обработка операций между множествами
+//обработка операций между множествами; результат - новое множество Set
+//(персистентный вариант с общими поддеревьями - в hamtSet.h, здесь он не дал бы выигрыша)
 void processSetOperation(const vector<string>& tokens) {
     if (tokens.size() < 3) {
         cout << "Недостаточно аргументов для операции с множествами" << endl;
@@ -196,21 +221,23 @@ void processSetOperation(const vector<string>& tokens) {
     string set2Name = (tokens.size() > 3) ? tokens[3] : "";
 
     //проверяем существование исходных множеств
-    if (sets.find(set1Name) == sets.end()) {
+    NamedSetPtr entry1 = sets.find(set1Name);
+    if (!entry1) {
         cout << "Множество '" << set1Name << "' не найдено" << endl;
         return;
     }
 
-    Set* set1 = sets[set1Name];
-    Set* set2 = nullptr;
-
-    if (!set2Name.empty() && sets.find(set2Name) == sets.end()) {
+    NamedSetPtr entry2 = set2Name.empty() ? nullptr : sets.find(set2Name);
+    if (!set2Name.empty() && !entry2) {
         cout << "Множество '" << set2Name << "' не найдено" << endl;
         return;
-    } else if (!set2Name.empty()) {
-        set2 = sets[set2Name];
     }
 
+    //оба операнда читаются под блокировками, взятыми в едином порядке
+    auto guards = lockShared({entry1, entry2});
+    Set* set1 = &entry1->set;
+    Set* set2 = entry2 ? &entry2->set : nullptr;
+
     Set result;
 
     if (command == "SUNION") {
@@ -244,19 +271,60 @@ void processSetOperation(const vector<string>& tokens) {
         return; //не создаем новое множество для SUBSET
     }
 
-    //сохраняем результат
-    if (sets.find(resultSetName) != sets.end()) {
-        destroySet(sets[resultSetName]);
-        delete sets[resultSetName];
+    guards.clear();
+    storeResult(resultSetName, result);
+    cout << "OK" << endl;
+}
+
+//сохранение результата операции под именем name (старое множество удаляется)
+void storeResult(const string& name, const Set& result) {
+    sets.put(name, result);
+}
+
+//вычисление выражения над множествами: SEVAL <результат> <выражение>,
+//а также n-арные SUNION/SINTER <результат> <множество1> <множество2> ...
+void processExpressionOperation(const vector<string>& tokens) {
+    string command = tokens[0];
+    if (tokens.size() < 3 || (command != "SEVAL" && tokens.size() < 4)) {
+        cout << "Недостаточно аргументов для " << command << endl;
+        return;
     }
-    sets[resultSetName] = new Set(result);
+
+    string expression;
+    if (command == "SEVAL") {
+        for (size_t i = 2; i < tokens.size(); i++) {
+            expression += tokens[i] + " ";
+        }
+    } else {
+        string op = (command == "SUNION") ? " | " : " & ";
+        expression = tokens[2];
+        for (size_t i = 3; i < tokens.size(); i++) {
+            expression += op + tokens[i];
+        }
+    }
+
+    //блокируем все операнды выражения до вычисления
+    vector<NamedSetPtr> entries;
+    map<string, Set*> operands;
+    for (const string& name : expressionSetNames(expression)) {
+        NamedSetPtr entry = sets.find(name);
+        if (entry) {
+            entries.push_back(entry);
+            operands[name] = &entry->set;
+        }
+    }
+
+    auto guards = lockShared(entries);
+    Set result = evaluateSetExpression(expression, operands);
+    guards.clear();
+    storeResult(tokens[1], result);
     cout << "OK" << endl;
 }
 
 //обработка операции разбиения множества
 void processPartitionOperation(const vector<string>& tokens) {
     if (tokens.size() < 4) {
-        cout << "Использование: SPARTITION <исходное_множество> <сумма_подмножества> <префикс_результата>" << endl;
+        cout << "Использование: SPARTITION <исходное_множество> <сумма_подмножества> <префикс_результата> [потоки]" << endl;
         return;
     }
 
@@ -264,13 +332,23 @@ void processPartitionOperation(const vector<string>& tokens) {
     int targetSum = stringToInt(tokens[2]);
     string resultPrefix = tokens[3];
 
+    //число потоков включает параллельный перебор (0 - по числу ядер, больше числа ядер не берется)
+    PartitionSolver solver = PartitionSolver::Auto;
+    int threads = 0;
+    if (tokens.size() > 4) {
+        solver = PartitionSolver::Parallel;
+        threads = stringToInt(tokens[4]);
+    }
+
     //проверяем существование исходного множества
-    if (sets.find(sourceSetName) == sets.end()) {
+    NamedSetPtr sourceEntry = sets.find(sourceSetName);
+    if (!sourceEntry) {
         cout << "Множество '" << sourceSetName << "' не найдено" << endl;
         return;
     }
 
-    Set* sourceSet = sets[sourceSetName];
+    shared_lock<shared_mutex> sourceGuard(sourceEntry->lock);
+    Set* sourceSet = &sourceEntry->set;
     
     if (empty(sourceSet)) {
         cout << "Исходное множество пусто" << endl;
@@ -281,27 +359,18 @@ void processPartitionOperation(const vector<string>& tokens) {
     
     cout << "Разбиение множества '" << sourceSetName << "' на подмножества с суммой " << targetSum << "..." << endl;
     
-    if (partitionSetImproved(sourceSet, targetSum, partitions)) {
+    bool found = partitionSetImproved(sourceSet, targetSum, partitions, solver, threads);
+    sourceGuard.unlock();
+
+    if (found) {
         cout << "Успешно создано " << partitions.size() << " подмножеств:" << endl;
         
         //сохраняем результаты как отдельные множества
         for (size_t i = 0; i < partitions.size(); i++) {
             string resultSetName = resultPrefix + "_" + to_string(i + 1);
             
-            //удаляем старое множество, если существует
-            if (sets.find(resultSetName) != sets.end()) {
-                destroySet(sets[resultSetName]);
-                delete sets[resultSetName];
-            }
-            
-            //создаем новое множество
-            sets[resultSetName] = new Set();
-            createSet(sets[resultSetName]);
-            
-            //заполняем элементами подмножества
-            for (int num : partitions[i]) {
-                insert(sets[resultSetName], num);
-            }
+            //создаем новое множество из элементов подмножества (старое заменяется)
+            storeResult(resultSetName, vectorToSet(partitions[i]));
             
             //выводим информацию о подмножестве
             cout << "Подмножество " << i + 1 << " (" << resultSetName << "): {";
@@ -324,19 +393,209 @@ void processPartitionOperation(const vector<string>& tokens) {
     }
 }
 
+//приближенные запросы по сводкам множеств
+void processSketchQuery(const vector<string>& tokens) {
+    string command = tokens[0];
+    size_t needed = (command == "SCARDEST") ? 2 : 3;
+    if (tokens.size() < needed) {
+        cout << command << " требует " << (needed == 2 ? "имя множества" : "два множества") << endl;
+        return;
+    }
+
+    vector<NamedSetPtr> entries;
+    for (size_t i = 1; i < needed; i++) {
+        NamedSetPtr entry = sets.find(tokens[i]);
+        if (!entry) {
+            cout << "Множество '" << tokens[i] << "' не найдено" << endl;
+            return;
+        }
+        entries.push_back(entry);
+    }
+
+    //устаревшая после удалений сводка перестраивается при запросе, поэтому блокировка монопольная
+    auto guards = lockExclusive(entries);
+    const Set* set1 = &entries[0]->set;
+    const Set* set2 = &entries.back()->set;
+
+    if (command == "SCARDEST") {
+        cout << llround(estimateCardinality(set1)) << endl;
+    }
+    else if (command == "SUNIONCARD") {
+        cout << llround(estimateUnionCardinality(set1, set2)) << endl;
+    }
+    else if (command == "SJACCARD") {
+        cout << fixed << setprecision(4) << estimateJaccard(set1, set2) << endl;
+    }
+}
+
+//запросы по порядку элементов через упорядоченный индекс
+void processOrderedQuery(const vector<string>& tokens) {
+    string command = tokens[0];
+    if (tokens.size() < 2) {
+        cout << command << " требует имя множества" << endl;
+        return;
+    }
+
+    string setName = tokens[1];
+    NamedSetPtr entry = sets.find(setName);
+    if (!entry) {
+        cout << "Множество '" << setName << "' не найдено" << endl;
+        return;
+    }
+
+    //индекс строится (сортировкой) при первом запросе и сохраняется в файле базы вместе
+    //с порядком элементов, поэтому следующие запуски восстанавливают его без сортировки
+    Set* set = &entry->set;
+    {
+        unique_lock<shared_mutex> guard(entry->lock);
+        enableOrderedIndex(set);
+    }
+    shared_lock<shared_mutex> guard(entry->lock);
+
+    if (command == "SRANGE") {
+        if (tokens.size() < 4) {
+            cout << "SRANGE требует границы отрезка" << endl;
+            return;
+        }
+        vector<int> keys = rangeQuery(set, stringToInt(tokens[2]), stringToInt(tokens[3]));
+        cout << "{";
+        for (size_t i = 0; i < keys.size(); i++) {
+            cout << keys[i];
+            if (i < keys.size() - 1) cout << ", ";
+        }
+        cout << "}" << endl;
+    }
+    else if (command == "SMIN" || command == "SMAX") {
+        int value;
+        bool found = (command == "SMIN") ? minElement(set, value) : maxElement(set, value);
+        if (found) {
+            cout << value << endl;
+        } else {
+            cout << "Множество '" << setName << "' пусто" << endl;
+        }
+    }
+    else if (command == "SRANK") {
+        if (tokens.size() < 3) {
+            cout << "SRANK требует значение" << endl;
+            return;
+        }
+        cout << rankOf(set, stringToInt(tokens[2])) << endl;
+    }
+}
+
+//двоичный формат базы выбирается по расширению .bin
+bool isBinaryFile(const string& filename) {
+    const string extension = ".bin";
+    return filename.size() >= extension.size() &&
+           filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+//двоичная база: "SET2", число множеств, затем для каждого длина имени, имя, флаги
+//(SET_FLAG_ORDERED - включен упорядоченный индекс) и закодированное множество.
+//файлы старого формата "SETB" без байта флагов читаются
+const uint8_t SET_FLAG_ORDERED = 1;
+
+void saveToBinaryFile(const string& filename) {
+    vector<uint8_t> bytes = {'S', 'E', 'T', '2'};
+    vector<string> names = sets.names();
+    uint32_t count = names.size();
+    bytes.insert(bytes.end(), reinterpret_cast<uint8_t*>(&count), reinterpret_cast<uint8_t*>(&count) + 4);
+
+    for (const string& name : names) {
+        NamedSetPtr entry = sets.find(name);
+        shared_lock<shared_mutex> guard(entry->lock);
+        uint32_t length = name.size();
+        bytes.insert(bytes.end(), reinterpret_cast<uint8_t*>(&length), reinterpret_cast<uint8_t*>(&length) + 4);
+        bytes.insert(bytes.end(), name.begin(), name.end());
+        bytes.push_back(entry->set.order ? SET_FLAG_ORDERED : 0);
+        encodeSet(&entry->set, bytes);
+    }
+
+    ofstream file(filename, ios::binary);
+    if (!file) {
+        cout << "Ошибка открытия файла для записи: " << filename << endl;
+        return;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    file.close();
+    cout << "Данные сохранены в файл: " << filename << endl;
+}
+
+void loadFromBinaryFile(const string& filename) {
+    ifstream file(filename, ios::binary);
+    if (!file) {
+        cout << "Файл '" << filename << "' не найден. Будет создан новый." << endl;
+        return;
+    }
+
+    vector<uint8_t> bytes((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+    const uint8_t* data = bytes.data();
+    const uint8_t* end = data + bytes.size();
+    bool withFlags = bytes.size() >= 8 && memcmp(data, "SET2", 4) == 0;
+    if (bytes.size() < 8 || (!withFlags && memcmp(data, "SETB", 4) != 0)) {
+        cout << "Файл '" << filename << "' не является двоичной базой множеств" << endl;
+        return;
+    }
+
+    uint32_t count;
+    memcpy(&count, data + 4, 4);
+    data += 8;
+
+    int loadedCount = 0;
+    try {
+        for (uint32_t i = 0; i < count; i++) {
+            uint32_t length;
+            if (end - data < 4) throw runtime_error("файл обрезан");
+            memcpy(&length, data, 4);
+            data += 4;
+            if (static_cast<size_t>(end - data) < length) throw runtime_error("файл обрезан");
+            string name(reinterpret_cast<const char*>(data), length);
+            data += length;
+            uint8_t flags = 0;
+            if (withFlags) {
+                if (data == end) throw runtime_error("файл обрезан");
+                flags = *data++;
+            }
+            sets.put(name, decodeSet(data, end, (flags & SET_FLAG_ORDERED) != 0));
+            loadedCount++;
+        }
+    } catch (const exception& e) {
+        cout << "Предупреждение: ошибка чтения двоичной базы: " << e.what() << endl;
+    }
+    cout << "Загружено " << loadedCount << " множеств из файла: " << filename << endl;
+}
+
 void saveToFile(const string& filename) {
+    if (isBinaryFile(filename)) {
+        saveToBinaryFile(filename);
+        return;
+    }
+
     ofstream file(filename);
     if (!file) {
         cout << "Ошибка открытия файла для записи: " << filename << endl;
         return;
     }
 
-    //сохранение множеств
-    for (const auto& pair : sets) {
-        file << "SET " << pair.first << " ";
+    //сохранение множеств; множества с упорядоченным индексом пишутся по возрастанию
+    //строкой OSET, чтобы при загрузке индекс восстановился без сортировки
+    for (const string& name : sets.names()) {
+        NamedSetPtr entry = sets.find(name);
+        if (!entry) continue;
+        shared_lock<shared_mutex> guard(entry->lock);
+        Set* set = &entry->set;
+        if (set->order) {
+            file << "OSET " << name << " ";
+            for (int key : sortedElements(set)) {
+                file << key << " ";
+            }
+            file << endl;
+            continue;
+        }
+
+        file << "SET " << name << " ";
         
         //сохраняем все элементы множества
-        Set* set = pair.second;
         for (int i = 0; i < set->tableSize; i++) {
             NodeSet* current = set->buckets[i];
             while (current != nullptr) {
@@ -352,6 +611,11 @@ void saveToFile(const string& filename) {
 }
 
 void loadFromFile(const string& filename) {
+    if (isBinaryFile(filename)) {
+        loadFromBinaryFile(filename);
+        return;
+    }
+
     ifstream file(filename);
     if (!file) {
         cout << "Файл '" << filename << "' не найден. Будет создан новый." << endl;
@@ -368,25 +632,31 @@ void loadFromFile(const string& filename) {
         string type = tokens[0];
         string name = tokens[1];
 
-        if (type == "SET") {
-            //удаляем старое множество, если существует
-            if (sets.find(name) != sets.end()) {
-                destroySet(sets[name]);
-                delete sets[name];
-            }
-            
-            sets[name] = new Set();
-            createSet(sets[name]);
+        if (type == "SET" || type == "OSET") {
+            //старое множество с тем же именем заменяется
+            Set set;
+            createSet(&set);
+            vector<int> keys;
             
             for (size_t i = 2; i < tokens.size(); i++) {
                 try {
                     int value = stringToInt(tokens[i]);
-                    insert(sets[name], value);
+                    if (insert(&set, value)) keys.push_back(value);
                 } catch (const exception& e) {
                     cout << "Предупреждение: неверный элемент '" << tokens[i] 
                          << "' в множестве '" << name << "' - пропущен" << endl;
                 }
             }
+
+            //OSET - множество с упорядоченным индексом, элементы записаны по возрастанию
+            if (type == "OSET") {
+                if (is_sorted(keys.begin(), keys.end())) {
+                    enableOrderedIndexSorted(&set, keys);
+                } else {
+                    enableOrderedIndex(&set);
+                }
+            }
+            sets.put(name, set);
             loadedCount++;
         }
     }
@@ -0,0 +1,95 @@
+#include "setStore.h"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+
+using namespace std;
+
+NamedSet::NamedSet() {
+    createSet(&set);
+}
+
+NamedSet::NamedSet(const Set& owned) : set(owned) {}
+
+NamedSet::~NamedSet() {
+    destroySet(&set);
+}
+
+SetStore::Shard& SetStore::shardOf(const string& name) {
+    return shards[hash<string>{}(name) % SHARDS];
+}
+
+const SetStore::Shard& SetStore::shardOf(const string& name) const {
+    return shards[hash<string>{}(name) % SHARDS];
+}
+
+//поиск множества; nullptr, если его нет
+NamedSetPtr SetStore::find(const string& name) const {
+    const Shard& shard = shardOf(name);
+    shared_lock<shared_mutex> guard(shard.lock);
+    auto it = shard.sets.find(name);
+    return it == shard.sets.end() ? nullptr : it->second;
+}
+
+//поиск множества с созданием пустого, если его нет
+NamedSetPtr SetStore::findOrCreate(const string& name) {
+    NamedSetPtr existing = find(name);
+    if (existing) return existing;
+
+    Shard& shard = shardOf(name);
+    unique_lock<shared_mutex> guard(shard.lock);
+    NamedSetPtr& slot = shard.sets[name];
+    if (!slot) slot = make_shared<NamedSet>();
+    return slot;
+}
+
+//сохранение множества под именем (старое множество заменяется)
+void SetStore::put(const string& name, const Set& set) {
+    NamedSetPtr entry = make_shared<NamedSet>(set);
+    Shard& shard = shardOf(name);
+    unique_lock<shared_mutex> guard(shard.lock);
+    shard.sets[name] = entry;
+}
+
+bool SetStore::erase(const string& name) {
+    Shard& shard = shardOf(name);
+    unique_lock<shared_mutex> guard(shard.lock);
+    return shard.sets.erase(name) > 0;
+}
+
+vector<string> SetStore::names() const {
+    vector<string> result;
+    for (const Shard& shard : shards) {
+        shared_lock<shared_mutex> guard(shard.lock);
+        for (const auto& pair : shard.sets) {
+            result.push_back(pair.first);
+        }
+    }
+    sort(result.begin(), result.end());
+    return result;
+}
+
+//упорядочивание по адресу и удаление повторов
+void orderForLocking(vector<NamedSetPtr>& entries) {
+    entries.erase(remove(entries.begin(), entries.end(), nullptr), entries.end());
+    sort(entries.begin(), entries.end(), less<NamedSetPtr>());
+    entries.erase(unique(entries.begin(), entries.end()), entries.end());
+}
+
+vector<shared_lock<shared_mutex>> lockShared(vector<NamedSetPtr> entries) {
+    orderForLocking(entries);
+    vector<shared_lock<shared_mutex>> locks;
+    for (const NamedSetPtr& entry : entries) {
+        locks.emplace_back(entry->lock);
+    }
+    return locks;
+}
+
+vector<unique_lock<shared_mutex>> lockExclusive(vector<NamedSetPtr> entries) {
+    orderForLocking(entries);
+    vector<unique_lock<shared_mutex>> locks;
+    for (const NamedSetPtr& entry : entries) {
+        locks.emplace_back(entry->lock);
+    }
+    return locks;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef SET_STORE_H
+#define SET_STORE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include "set.h"
+
+//именованное множество со своей блокировкой чтения/записи:
+//читатели (contains, size, print) берут shared_lock, изменяющие операции - unique_lock
+struct NamedSet {
+    Set set;
+    mutable std::shared_mutex lock;
+
+    NamedSet();
+    explicit NamedSet(const Set& owned); //множество переходит во владение
+    ~NamedSet();
+    NamedSet(const NamedSet&) = delete;
+    NamedSet& operator=(const NamedSet&) = delete;
+};
+
+typedef std::shared_ptr<NamedSet> NamedSetPtr;
+
+//потокобезопасное хранилище множеств по именам: таблица разбита на сегменты
+//со своими блокировками, запись читают сразу несколько потоков.
+//замененное множество освобождается, когда его отпустит последний читатель
+class SetStore {
+private:
+    static const int SHARDS = 16;
+
+    struct Shard {
+        mutable std::shared_mutex lock;
+        std::unordered_map<std::string, NamedSetPtr> sets;
+    };
+
+    Shard shards[SHARDS];
+
+    Shard& shardOf(const std::string& name);
+    const Shard& shardOf(const std::string& name) const;
+
+public:
+    NamedSetPtr find(const std::string& name) const;
+    NamedSetPtr findOrCreate(const std::string& name);
+    void put(const std::string& name, const Set& set);
+    bool erase(const std::string& name);
+    std::vector<std::string> names() const; //по алфавиту
+};
+
+//блокировки нескольких множеств берутся в едином порядке (по адресу), чтобы
+//бинарные операции из разных потоков не блокировали друг друга навсегда
+std::vector<std::shared_lock<std::shared_mutex>> lockShared(std::vector<NamedSetPtr> entries);
+std::vector<std::unique_lock<std::shared_mutex>> lockExclusive(std::vector<NamedSetPtr> entries);
+
+#endif
\ No newline at end of file